@@ -26,6 +26,7 @@
 #include <map>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 
@@ -135,17 +136,27 @@ void writeUserNotes(LineWriter& wLn, const juce::ValueTree& valueTree)
 
 int main(int argc, char* argv[])
 {
-  if (argc != 3)
+  auto args = std::vector<juce::String>{argv, argv + argc};
+
+  const auto profileConfigurationOption = juce::String{"--profile-configuration"};
+  const auto profileConfigurationOptionIt =
+    std::find(args.begin(), args.end(), profileConfigurationOption);
+  const auto addProfileConfiguration = profileConfigurationOptionIt != args.end();
+  if (addProfileConfiguration)
+  {
+    args.erase(profileConfigurationOptionIt);
+  }
+
+  if (args.size() != 3)
   {
     std::cerr << "usage: Jucer2Reprojucer"
+                 " [--profile-configuration]"
                  " <jucer_project_file>"
                  " <Reprojucer.cmake_file>"
               << std::endl;
     return 1;
   }
 
-  const auto args = std::vector<juce::String>{argv, argv + argc};
-
   const auto& jucerFilePath = args.at(1);
   const auto jucerFile =
     juce::File::getCurrentWorkingDirectory().getChildFile(jucerFilePath);
@@ -545,7 +556,8 @@ int main(int argc, char* argv[])
   {
     const auto writeFiles =
       [&wLn](const juce::String& fullGroupName,
-             const std::vector<std::tuple<bool, bool, bool, juce::String>>& files) {
+             const std::vector<std::tuple<bool, bool, bool, juce::String, juce::String>>&
+               files) {
         if (!files.empty())
         {
           const auto nineSpaces = "         ";
@@ -560,9 +572,13 @@ int main(int argc, char* argv[])
             const auto xcodeResource = std::get<1>(file);
             const auto binaryResource = std::get<2>(file);
             const auto path = std::get<3>(file);
+            const auto compilerFlagScheme = std::get<4>(file);
 
             wLn("  ", (compile ? "x" : "."), nineSpaces, (xcodeResource ? "x" : "."),
-                nineSpaces, (binaryResource ? "x" : "."), nineSpaces, "\"", path, "\"");
+                nineSpaces, (binaryResource ? "x" : "."), nineSpaces, "\"", path, "\"",
+                (compilerFlagScheme.isEmpty()
+                   ? juce::String{}
+                   : " COMPILER_FLAG_SCHEME \"" + compilerFlagScheme + "\""));
           }
 
           wLn(")");
@@ -578,7 +594,7 @@ int main(int argc, char* argv[])
 
         const auto fullGroupName = groupNames.joinIntoString("/");
 
-        std::vector<std::tuple<bool, bool, bool, juce::String>> files;
+        std::vector<std::tuple<bool, bool, bool, juce::String, juce::String>> files;
 
         for (auto i = 0; i < group.getNumChildren(); ++i)
         {
@@ -591,7 +607,8 @@ int main(int argc, char* argv[])
             files.emplace_back(int{file.getProperty("compile")} == 1,
                                int{file.getProperty("xcodeResource")} == 1,
                                int{file.getProperty("resource")} == 1,
-                               file.getProperty("file").toString());
+                               file.getProperty("file").toString(),
+                               file.getProperty("compilerFlagScheme").toString());
           }
           else
           {
@@ -834,6 +851,19 @@ int main(int argc, char* argv[])
       convertSettingAsListIfDefined(exporter, "externalLibraries",
                                     "EXTERNAL_LIBRARIES_TO_LINK", {});
 
+      const auto compilerFlagSchemes = juce::StringArray::fromTokens(
+        jucerProject.getProperty("compilerFlagSchemes").toString(), ",", {});
+      if (!compilerFlagSchemes.isEmpty())
+      {
+        wLn("  COMPILER_FLAG_SCHEMES");
+
+        for (const auto& scheme : compilerFlagSchemes)
+        {
+          wLn("    \"", escape("\\\";", scheme), "\" \"",
+              escape("\\\";", exporter.getProperty(scheme).toString()), "\"");
+        }
+      }
+
       convertOnOffSettingIfDefined(exporter, "enableGNUExtensions",
                                    "GNU_COMPILER_EXTENSIONS", {});
 
@@ -974,13 +1004,31 @@ int main(int argc, char* argv[])
       wLn(")");
       wLn();
 
+      // With --profile-configuration, the "Release" configuration of the Linux Makefile
+      // exporter is written a second time as a "Profile" configuration
+      std::vector<std::pair<juce::ValueTree, juce::String>> configurationsToWrite;
       for (auto i = 0; i < configurations.getNumChildren(); ++i)
       {
         const auto configuration = configurations.getChild(i);
+        const auto configurationName = configuration.getProperty("name").toString();
+        configurationsToWrite.emplace_back(configuration, configurationName);
+
+        if (addProfileConfiguration && exporterType == "LINUX_MAKE"
+            && configurationName == "Release"
+            && !configurations.getChildWithProperty("name", "Profile").isValid())
+        {
+          configurationsToWrite.emplace_back(configuration, "Profile");
+        }
+      }
+
+      for (const auto& configurationToWrite : configurationsToWrite)
+      {
+        const auto& configuration = configurationToWrite.first;
+        const auto& configurationName = configurationToWrite.second;
 
         wLn("jucer_export_target_configuration(");
         wLn("  \"", exporterName, "\"");
-        wLn("  NAME \"", configuration.getProperty("name").toString(), "\"");
+        wLn("  NAME \"", configurationName, "\"");
         wLn("  DEBUG_MODE ", (bool{configuration.getProperty("isDebug")} ? "ON" : "OFF"));
 
         convertSettingIfDefined(configuration, "targetName", "BINARY_NAME", {});
@@ -1348,6 +1396,16 @@ int main(int argc, char* argv[])
 
                                     return {};
                                   });
+
+          convertOnOffSettingIfDefined(configuration, "linkTimeOptimisation",
+                                       "LINK_TIME_OPTIMISATION", {});
+
+          const auto isAddedProfileConfiguration =
+            configurationName != configuration.getProperty("name").toString();
+          if (isAddedProfileConfiguration)
+          {
+            wLn("  PROFILING \"perf\"");
+          }
         }
 
         writeUserNotes(wLn, configuration);
@@ -1,62 +0,0 @@
-// Copyright (c) 2017 Alain Martin
-//
-// This file is part of FRUT.
-//
-// FRUT is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// FRUT is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
-
-// clang-format off
-
-// From line 24 onward, the content of this file was copied from
-// https://github.com/WeAreROLI/JUCE/blob/4.3.1/extras/Projucer/Source/Utility/jucer_FileHelpers.h
-
-
-/*
-  ==============================================================================
-
-   This file is part of the JUCE library.
-   Copyright (c) 2015 - ROLI Ltd.
-
-   Permission is granted to use this software under the terms of either:
-   a) the GPL v2 (or any later version)
-   b) the Affero GPL v3
-
-   Details of these licenses can be found at: www.gnu.org/licenses
-
-   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
-   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
-   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
-
-   ------------------------------------------------------------------------------
-
-   To release a closed-source product which uses JUCE, commercial licenses are
-   available: visit www.juce.com for more information.
-
-  ==============================================================================
-*/
-
-#ifndef JUCER_FILEHELPERS_H_INCLUDED
-#define JUCER_FILEHELPERS_H_INCLUDED
-
-
-namespace FileHelpers
-{
-    int64 calculateStreamHashCode (InputStream& stream);
-    int64 calculateFileHashCode (const File& file);
-
-    bool overwriteFileWithNewDataIfDifferent (const File& file, const void* data, size_t numBytes);
-    bool overwriteFileWithNewDataIfDifferent (const File& file, const MemoryOutputStream& newData);
-}
-
-
-#endif   // JUCER_FILEHELPERS_H_INCLUDED
@@ -1,25 +0,0 @@
-// Copyright (c) 2017 Alain Martin
-//
-// This file is part of FRUT.
-//
-// FRUT is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// FRUT is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
-
-#pragma once
-
-#include <juce_core/juce_core.h>
-#include <juce_graphics/juce_graphics.h>
-#include <juce_gui_basics/juce_gui_basics.h>
-using namespace juce;
-
-#include "Utility/jucer_FileHelpers.h"
@@ -41,8 +41,50 @@ set(Reprojucer_supported_exporters_conditions
 
 function(jucer_project_begin)
 
+  set(FRUT_PROFILE_CONFIGURE OFF CACHE BOOL
+    "Write a trace and a summary of the time spent in Reprojucer.cmake when configuring"
+  )
+  if(FRUT_PROFILE_CONFIGURE)
+    if(CMAKE_VERSION VERSION_LESS 3.23)
+      message(FATAL_ERROR "FRUT_PROFILE_CONFIGURE requires at least CMake version 3.23")
+    endif()
+    string(TIMESTAMP origin "%s%f")
+    set_property(GLOBAL PROPERTY FRUT_PROFILE_ORIGIN "${origin}")
+    set_property(GLOBAL PROPERTY FRUT_PROFILE_EVENTS "")
+    set_property(GLOBAL PROPERTY FRUT_PROFILE_STACK "")
+  endif()
+
+  set(FRUT_COMPILE_TIME_REPORT OFF CACHE BOOL
+    "Trace the compilation of each source file, and add <target>_Compile_Time_Report"
+  )
+  if(FRUT_COMPILE_TIME_REPORT)
+    if(NOT CMAKE_GENERATOR MATCHES "Makefiles|Ninja")
+      message(FATAL_ERROR "FRUT_COMPILE_TIME_REPORT is only supported with the Makefile"
+        " and Ninja generators"
+      )
+    endif()
+    # -ftime-trace was added in Clang 9
+    if(NOT (CMAKE_CXX_COMPILER_ID STREQUAL "GNU"
+        OR (CMAKE_CXX_COMPILER_ID STREQUAL "Clang"
+          AND NOT CMAKE_CXX_COMPILER_VERSION VERSION_LESS 9)
+        OR (CMAKE_CXX_COMPILER_ID STREQUAL "AppleClang"
+          AND NOT CMAKE_CXX_COMPILER_VERSION VERSION_LESS 11.0.3)))
+      message(FATAL_ERROR "FRUT_COMPILE_TIME_REPORT requires GCC, Clang 9 or later, or"
+        " AppleClang 11.0.3 or later"
+      )
+    endif()
+  endif()
+
+  _FRUT_profile_begin(jucer_project_begin)
+
   _FRUT_parse_arguments("JUCER_VERSION;PROJECT_FILE;PROJECT_ID" "" "${ARGN}")
 
+  # The files collected by jucer_project_files() for a previous project of the build tree
+  # that didn't call jucer_project_end() must not end up in this project
+  foreach(list_name SOURCES RESOURCES XCODE_RESOURCES WITH_SCHEME)
+    set_property(GLOBAL PROPERTY FRUT_PROJECT_FILES_${list_name} "")
+  endforeach()
+
   if(DEFINED _JUCER_VERSION)
     set(JUCER_VERSION "${_JUCER_VERSION}" PARENT_SCOPE)
   endif()
@@ -59,11 +101,23 @@ function(jucer_project_begin)
     set(JUCER_PROJECT_ID "${_PROJECT_ID}" PARENT_SCOPE)
   endif()
 
+  # The instrumented build of PROFILE_GUIDED_OPTIMISATION uses the generated files of the
+  # project, since GCC and Clang identify some functions with the path of their file
+  if(DEFINED _FRUT_PGO_BINARY_DIR)
+    set(JUCER_LIBRARY_CODE_DIR "${_FRUT_PGO_BINARY_DIR}/JuceLibraryCode" PARENT_SCOPE)
+  else()
+    set(JUCER_LIBRARY_CODE_DIR "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode" PARENT_SCOPE)
+  endif()
+
+  _FRUT_profile_end(jucer_project_begin)
+
 endfunction()
 
 
 function(jucer_project_settings)
 
+  _FRUT_profile_begin(jucer_project_settings)
+
   set(single_value_keywords
     "PROJECT_NAME"
     "PROJECT_VERSION"
@@ -159,11 +213,15 @@ function(jucer_project_settings)
     endif()
   endforeach()
 
+  _FRUT_profile_end(jucer_project_settings)
+
 endfunction()
 
 
 function(jucer_audio_plugin_settings)
 
+  _FRUT_profile_begin(jucer_audio_plugin_settings)
+
   set(single_value_keywords
     "BUILD_VST"
     "BUILD_VST3"
@@ -226,73 +284,186 @@ function(jucer_audio_plugin_settings)
     endif()
   endforeach()
 
+  _FRUT_profile_end(jucer_audio_plugin_settings)
+
 endfunction()
 
 
 function(jucer_project_files source_group_name)
 
-  function(__check_input input)
-    if(NOT input STREQUAL "x" AND NOT input STREQUAL ".")
-      message(FATAL_ERROR "Expected x or . token, got ${input} instead")
-    endif()
-  endfunction()
+  _FRUT_profile_begin(jucer_project_files)
 
+  # The files are sorted into one list per property, so that the properties are set with
+  # one call of set_source_files_properties() per list, instead of one call per file
   unset(compile)
   unset(xcode_resource)
   unset(binary_resource)
   unset(files)
-  foreach(element ${ARGN})
-    if(NOT DEFINED compile)
-      set(compile ${element})
-      __check_input("${compile}")
-    elseif(NOT DEFINED xcode_resource)
-      set(xcode_resource ${element})
-      __check_input("${xcode_resource}")
-    elseif(NOT DEFINED binary_resource)
-      set(binary_resource ${element})
-      __check_input("${binary_resource}")
-    else()
-      set(path ${element})
+  unset(sources)
+  unset(resources)
+  unset(xcode_resources)
+  unset(header_only_files)
+  unset(group_compiler_flag_scheme)
+  unset(file_compiler_flag_schemes)
+  unset(path)
+
+  # Fast path for the groups written by Jucer2Reprojucer, which only contain
+  # <compile> <xcode_resource> <binary_resource> <file_path> tuples, with paths that are
+  # all relative or all absolute, and without "." or ".." components. The whole group is
+  # then handled by a few string(REGEX) calls, instead of several commands per file.
+  set(use_fast_path FALSE)
+  set(arguments "${ARGN}")
+  if(NOT arguments MATCHES "\\||\\\\|//")
+    # Each file becomes a <compile><xcode_resource><binary_resource>|<file_path> item
+    string(REGEX REPLACE "([x.]);([x.]);([x.]);([^;]+)(;|$)" "\\1\\2\\3|\\4\\5"
+      items "${arguments}"
+    )
+    string(REGEX REPLACE "(^|;)[x.][x.][x.]\\|[^;]*" "" unexpected_items "${items}")
+    if(unexpected_items STREQUAL "" AND NOT items MATCHES "[|/]\\.\\.?(/|;|$)|/(;|$)")
+      if(NOT items MATCHES "\\|(/|[A-Za-z]:/)")
+        if(DEFINED JUCER_PROJECT_DIR)
+          get_filename_component(project_dir "${JUCER_PROJECT_DIR}" ABSOLUTE)
+          if(NOT project_dir MATCHES "\\|")
+            string(REPLACE "|" "|${project_dir}/" items "${items}")
+            set(use_fast_path TRUE)
+          endif()
+        endif()
+      elseif(NOT items MATCHES "\\|([^/A-Za-z]|[A-Za-z]([^:]|$))")
+        set(use_fast_path TRUE)
+      endif()
+    endif()
+  endif()
 
-      _FRUT_abs_path_based_on_jucer_project_dir("${path}" path)
-      list(APPEND files "${path}")
+  if(use_fast_path)
+    # The <compile> flag of the headers becomes h, and the one of the .mm files that
+    # must not be compiled becomes m, so that each list is matched by one regex
+    string(REGEX REPLACE "\\.\\.\\.\\|([^;]*/[^/;.]*\\.h)(;|$)" "h..|\\1\\2"
+      items "${items}"
+    )
+    if(NOT APPLE)
+      string(REGEX REPLACE "x\\.\\.\\|([^;]*/[^/;.]*\\.mm)(;|$)" "m..|\\1\\2"
+        items "${items}"
+      )
+    endif()
+    string(REGEX MATCHALL "[x.hm]\\.\\.\\|[^;]*" sources "${items}")
+    string(REGEX MATCHALL "[.m]\\.\\.\\|[^;]*" header_only_files "${items}")
+    string(REGEX MATCHALL "[x.]\\.x\\|[^;]*" resources "${items}")
+    string(REGEX MATCHALL "[x.]x[x.]\\|[^;]*" xcode_resources "${items}")
+    set(files "${items}")
+    foreach(list_name files sources header_only_files resources xcode_resources)
+      string(REGEX REPLACE "[x.hm][x.][x.]\\|" "" ${list_name} "${${list_name}}")
+    endforeach()
 
-      if(xcode_resource STREQUAL "x")
-        list(APPEND JUCER_PROJECT_XCODE_RESOURCES "${path}")
-      elseif(binary_resource STREQUAL "x")
-        list(APPEND JUCER_PROJECT_RESOURCES "${path}")
+  else()
+    set(tag "")
+    foreach(element ${ARGN})
+      if(tag STREQUAL "COMPILER_FLAG_SCHEME")
+        if(DEFINED path)
+          list(FIND file_compiler_flag_schemes "${element}" scheme_index)
+          if(scheme_index EQUAL -1)
+            list(LENGTH file_compiler_flag_schemes scheme_index)
+            list(APPEND file_compiler_flag_schemes "${element}")
+          endif()
+          list(APPEND scheme_${scheme_index}_files "${path}")
+        else()
+          set(group_compiler_flag_scheme "${element}")
+        endif()
+        set(tag "")
+      elseif(element STREQUAL "COMPILER_FLAG_SCHEME" AND NOT DEFINED compile)
+        set(tag ${element})
+      elseif(NOT DEFINED binary_resource)
+        if(NOT element STREQUAL "x" AND NOT element STREQUAL ".")
+          message(FATAL_ERROR "Expected x or . token, got ${element} instead")
+        endif()
+        if(NOT DEFINED compile)
+          set(compile ${element})
+        elseif(NOT DEFINED xcode_resource)
+          set(xcode_resource ${element})
+        else()
+          set(binary_resource ${element})
+        endif()
       else()
-        list(APPEND JUCER_PROJECT_SOURCES "${path}")
+        # Same as _FRUT_abs_path_based_on_jucer_project_dir(), without the function call
+        if(NOT IS_ABSOLUTE "${element}" AND NOT DEFINED JUCER_PROJECT_DIR)
+          _FRUT_abs_path_based_on_jucer_project_dir("${element}" path)
+        endif()
+        get_filename_component(path "${element}" ABSOLUTE BASE_DIR "${JUCER_PROJECT_DIR}")
+        list(APPEND files "${path}")
 
-        get_filename_component(file_extension "${path}" EXT)
+        if(xcode_resource STREQUAL "x")
+          list(APPEND xcode_resources "${path}")
+        elseif(binary_resource STREQUAL "x")
+          list(APPEND resources "${path}")
+        else()
+          list(APPEND sources "${path}")
 
-        if(NOT file_extension STREQUAL ".h" AND compile STREQUAL ".")
-          set_source_files_properties("${path}" PROPERTIES HEADER_FILE_ONLY TRUE)
+          # Same as comparing the EXT component of the path to ".h" and ".mm"
+          if(NOT path MATCHES "/[^/.]*\\.h$" AND compile STREQUAL ".")
+            list(APPEND header_only_files "${path}")
+          elseif(path MATCHES "/[^/.]*\\.mm$" AND NOT APPLE)
+            list(APPEND header_only_files "${path}")
+          endif()
         endif()
 
-        if(file_extension STREQUAL ".mm" AND NOT APPLE)
-          set_source_files_properties("${path}" PROPERTIES HEADER_FILE_ONLY TRUE)
-        endif()
+        unset(compile)
+        unset(xcode_resource)
+        unset(binary_resource)
       endif()
+    endforeach()
+  endif()
 
-      unset(compile)
-      unset(xcode_resource)
-      unset(binary_resource)
-    endif()
+  if(header_only_files)
+    set_source_files_properties(${header_only_files} PROPERTIES HEADER_FILE_ONLY TRUE)
+  endif()
+
+  # The scheme of a file overrides the scheme of its group. The files that have a scheme
+  # are also collected in a global property, so that jucer_project_end() only looks at
+  # them.
+  if(DEFINED group_compiler_flag_scheme AND sources)
+    set_source_files_properties(${sources} PROPERTIES
+      FRUT_COMPILER_FLAG_SCHEME "${group_compiler_flag_scheme}"
+    )
+    set_property(GLOBAL APPEND PROPERTY FRUT_PROJECT_FILES_WITH_SCHEME ${sources})
+  endif()
+  set(scheme_index 0)
+  foreach(scheme ${file_compiler_flag_schemes})
+    set_source_files_properties(${scheme_${scheme_index}_files} PROPERTIES
+      FRUT_COMPILER_FLAG_SCHEME "${scheme}"
+    )
+    set_property(GLOBAL APPEND PROPERTY FRUT_PROJECT_FILES_WITH_SCHEME
+      ${scheme_${scheme_index}_files}
+    )
+    math(EXPR scheme_index "${scheme_index} + 1")
   endforeach()
 
+  # The compile time report attributes the time of each source file to its group
+  if(FRUT_COMPILE_TIME_REPORT AND sources)
+    set_source_files_properties(${sources} PROPERTIES
+      FRUT_SOURCE_GROUP "${source_group_name}"
+    )
+  endif()
+
   string(REPLACE "/" "\\" source_group_name ${source_group_name})
   source_group(${source_group_name} FILES ${files})
 
-  set(JUCER_PROJECT_SOURCES ${JUCER_PROJECT_SOURCES} PARENT_SCOPE)
-  set(JUCER_PROJECT_RESOURCES ${JUCER_PROJECT_RESOURCES} PARENT_SCOPE)
-  set(JUCER_PROJECT_XCODE_RESOURCES ${JUCER_PROJECT_XCODE_RESOURCES} PARENT_SCOPE)
+  # Copying JUCER_PROJECT_SOURCES to the parent scope after each group would make adding
+  # N groups O(N^2), so the files are collected in global properties instead, until
+  # jucer_project_end() adds them to JUCER_PROJECT_SOURCES and the other lists
+  set_property(GLOBAL APPEND PROPERTY FRUT_PROJECT_FILES_SOURCES ${sources})
+  set_property(GLOBAL APPEND PROPERTY FRUT_PROJECT_FILES_RESOURCES ${resources})
+  set_property(GLOBAL APPEND PROPERTY FRUT_PROJECT_FILES_XCODE_RESOURCES
+    ${xcode_resources}
+  )
+
+  _FRUT_profile_end(jucer_project_files "${source_group_name}")
 
 endfunction()
 
 
 function(jucer_project_module module_name PATH_KEYWORD modules_folder)
 
+  _FRUT_profile_begin(jucer_project_module)
+
   list(APPEND JUCER_PROJECT_MODULES ${module_name})
   set(JUCER_PROJECT_MODULES ${JUCER_PROJECT_MODULES} PARENT_SCOPE)
 
@@ -303,10 +474,8 @@ function(jucer_project_module module_name PATH_KEYWORD modules_folder)
   list(APPEND JUCER_PROJECT_MODULES_FOLDERS "${modules_folder}")
   set(JUCER_PROJECT_MODULES_FOLDERS ${JUCER_PROJECT_MODULES_FOLDERS} PARENT_SCOPE)
 
-  file(GLOB module_src_files
-    "${modules_folder}/${module_name}/*.cpp"
-    "${modules_folder}/${module_name}/*.mm"
-  )
+  _FRUT_get_module_metadata_file("${modules_folder}" "${module_name}" metadata_file)
+  include("${metadata_file}")
 
   if(DEFINED JUCER_VERSION AND JUCER_VERSION VERSION_LESS 5.0.0)
     set(proxy_prefix)
@@ -314,6 +483,21 @@ function(jucer_project_module module_name PATH_KEYWORD modules_folder)
     set(proxy_prefix "include_")
   endif()
 
+  set(FRUT_SPLIT_JUCE_MODULES "" CACHE STRING
+    "List of the JUCE modules to compile as several translation units"
+  )
+  set(split_module FALSE)
+  if("${module_name}" IN_LIST FRUT_SPLIT_JUCE_MODULES)
+    set(split_module TRUE)
+    foreach(src_file ${module_src_files})
+      # The module already provides split entry points (e.g. juce_xxx_1.cpp)
+      if(src_file MATCHES "/${module_name}_[0-9]+\\.(cpp|mm)$")
+        set(split_module FALSE)
+      endif()
+    endforeach()
+  endif()
+
+  unset(module_wrappers)
   foreach(src_file ${module_src_files})
     unset(to_compile)
 
@@ -355,21 +539,38 @@ function(jucer_project_module module_name PATH_KEYWORD modules_folder)
 
     if(to_compile)
       get_filename_component(src_file_basename "${src_file}" NAME)
-      configure_file("${Reprojucer_templates_DIR}/JuceLibraryCode-Wrapper.cpp"
-        "JuceLibraryCode/${proxy_prefix}${src_file_basename}"
-      )
-      list(APPEND JUCER_PROJECT_SOURCES
-        "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode/${proxy_prefix}${src_file_basename}"
-      )
+      get_filename_component(src_file_basename_we "${src_file}" NAME_WE)
+      unset(split_wrappers)
+      if(src_file_basename_we STREQUAL module_name AND split_module)
+        _FRUT_split_module_source_file("${module_name}" "${modules_folder}"
+          "${src_file}" "${proxy_prefix}" split_wrappers
+        )
+      endif()
+      if(split_wrappers)
+        list(APPEND module_wrappers ${split_wrappers})
+      else()
+        configure_file("${Reprojucer_templates_DIR}/JuceLibraryCode-Wrapper.cpp"
+          "${JUCER_LIBRARY_CODE_DIR}/${proxy_prefix}${src_file_basename}"
+        )
+        list(APPEND module_wrappers
+          "${JUCER_LIBRARY_CODE_DIR}/${proxy_prefix}${src_file_basename}"
+        )
+      endif()
     endif()
   endforeach()
 
-  set(JUCER_PROJECT_SOURCES ${JUCER_PROJECT_SOURCES} PARENT_SCOPE)
+  if(module_wrappers)
+    list(APPEND JUCER_PROJECT_SOURCES ${module_wrappers})
+    # The compile time report attributes the time of each wrapper to its module
+    if(FRUT_COMPILE_TIME_REPORT)
+      set_source_files_properties(${module_wrappers} PROPERTIES
+        FRUT_JUCE_MODULE "${module_name}"
+      )
+    endif()
+  endif()
 
-  set(module_header_file "${modules_folder}/${module_name}/${module_name}.h")
+  set(JUCER_PROJECT_SOURCES ${JUCER_PROJECT_SOURCES} PARENT_SCOPE)
 
-  file(STRINGS "${module_header_file}" config_flags_lines REGEX "/\\*\\* Config: ")
-  string(REPLACE "/** Config: " "" module_config_flags "${config_flags_lines}")
   set(JUCER_${module_name}_CONFIG_FLAGS ${module_config_flags} PARENT_SCOPE)
 
   unset(config_flag)
@@ -386,35 +587,6 @@ function(jucer_project_module module_name PATH_KEYWORD modules_folder)
     endif()
   endforeach()
 
-  unset(module_info_OSXFrameworks)
-  unset(module_info_linuxLibs)
-  unset(module_info_linuxPackages)
-  unset(module_info_minimumCppStandard)
-
-  file(STRINGS "${module_header_file}" all_lines)
-  set(in_module_declaration FALSE)
-  foreach(line ${all_lines})
-    string(STRIP "${line}" stripped_line)
-    if(stripped_line MATCHES "^BEGIN_JUCE_MODULE_DECLARATION")
-      set(in_module_declaration TRUE)
-      continue()
-    elseif(stripped_line MATCHES "^END_JUCE_MODULE_DECLARATION")
-      break()
-    endif()
-
-    if(in_module_declaration)
-      string(FIND "${line}" ":" colon_pos)
-      if(NOT colon_pos EQUAL -1)
-        string(SUBSTRING "${line}" 0 ${colon_pos} key)
-        string(STRIP "${key}" key)
-        math(EXPR colon_pos_plus_one "${colon_pos} + 1")
-        string(SUBSTRING "${line}" ${colon_pos_plus_one} -1 value)
-        string(STRIP "${value}" value)
-        set(module_info_${key} ${value})
-      endif()
-    endif()
-  endforeach()
-
   string(REPLACE " " ";" osx_frameworks "${module_info_OSXFrameworks}")
   string(REPLACE "," ";" osx_frameworks "${osx_frameworks}")
   list(APPEND JUCER_PROJECT_OSX_FRAMEWORKS ${osx_frameworks})
@@ -448,21 +620,24 @@ function(jucer_project_module module_name PATH_KEYWORD modules_folder)
     endif()
   endif()
 
-  file(GLOB_RECURSE browsable_files "${modules_folder}/${module_name}/*")
-  foreach(file_path ${browsable_files})
+  foreach(file_path ${module_browsable_files})
     get_filename_component(file_dir "${file_path}" DIRECTORY)
     string(REPLACE "${modules_folder}" "" rel_file_dir "${file_dir}")
     string(REPLACE "/" "\\" sub_group_name "${rel_file_dir}")
     source_group("Juce Modules${sub_group_name}" FILES "${file_path}")
   endforeach()
-  list(APPEND JUCER_PROJECT_BROWSABLE_FILES ${browsable_files})
+  list(APPEND JUCER_PROJECT_BROWSABLE_FILES ${module_browsable_files})
   set(JUCER_PROJECT_BROWSABLE_FILES ${JUCER_PROJECT_BROWSABLE_FILES} PARENT_SCOPE)
 
+  _FRUT_profile_end(jucer_project_module "${module_name}")
+
 endfunction()
 
 
 function(jucer_appconfig_header USER_CODE_SECTION_KEYWORD user_code_section)
 
+  _FRUT_profile_begin(jucer_appconfig_header)
+
   if(NOT USER_CODE_SECTION_KEYWORD STREQUAL "USER_CODE_SECTION")
     message(FATAL_ERROR "Invalid second argument. Expected \"USER_CODE_SECTION\" "
       "keyword, but got \"${USER_CODE_SECTION_KEYWORD}\" instead."
@@ -471,11 +646,15 @@ function(jucer_appconfig_header USER_CODE_SECTION_KEYWORD user_code_section)
 
   set(JUCER_APPCONFIG_USER_CODE_SECTION "${user_code_section}" PARENT_SCOPE)
 
+  _FRUT_profile_end(jucer_appconfig_header)
+
 endfunction()
 
 
 function(jucer_export_target exporter)
 
+  _FRUT_profile_begin(jucer_export_target)
+
   if(NOT "${exporter}" IN_LIST Reprojucer_supported_exporters)
     message(FATAL_ERROR "Unsupported exporter: ${exporter}\n"
       "Supported exporters: ${Reprojucer_supported_exporters}"
@@ -487,6 +666,7 @@ function(jucer_export_target exporter)
   list(FIND Reprojucer_supported_exporters "${exporter}" exporter_index)
   list(GET Reprojucer_supported_exporters_conditions ${exporter_index} condition)
   if(NOT ${condition})
+    _FRUT_profile_end(jucer_export_target)
     return()
   endif()
 
@@ -495,12 +675,14 @@ function(jucer_export_target exporter)
     "VST_SDK_FOLDER"
     "ICON_SMALL"
     "ICON_LARGE"
+    "COMPILER_CACHE"
   )
   set(multi_value_keywords
     "EXTRA_PREPROCESSOR_DEFINITIONS"
     "EXTRA_COMPILER_FLAGS"
     "EXTRA_LINKER_FLAGS"
     "EXTERNAL_LIBRARIES_TO_LINK"
+    "COMPILER_FLAG_SCHEMES"
   )
 
   if(exporter STREQUAL "Xcode (MacOSX)")
@@ -547,8 +729,15 @@ function(jucer_export_target exporter)
     list(APPEND single_value_keywords
       "CXX_STANDARD_TO_USE"
     )
+    list(APPEND single_value_keywords
+      "PLUGIN_LOAD_TIME_OPTIMISATION"
+      "VECTORISATION_REPORT"
+      "VECTORISATION_REPORT_BASELINE"
+    )
     list(APPEND multi_value_keywords
       "PKGCONFIG_LIBRARIES"
+      "MULTI_ISA_SOURCES"
+      "MULTI_ISA_LEVELS"
     )
   endif()
 
@@ -602,10 +791,25 @@ function(jucer_export_target exporter)
     set(JUCER_EXTERNAL_LIBRARIES_TO_LINK ${_EXTERNAL_LIBRARIES_TO_LINK} PARENT_SCOPE)
   endif()
 
+  if(DEFINED _COMPILER_FLAG_SCHEMES)
+    _FRUT_check_compiler_flag_schemes("${_COMPILER_FLAG_SCHEMES}")
+    set(JUCER_COMPILER_FLAG_SCHEMES "${_COMPILER_FLAG_SCHEMES}" PARENT_SCOPE)
+  endif()
+
   if(DEFINED _GNU_COMPILER_EXTENSIONS)
     set(JUCER_GNU_COMPILER_EXTENSIONS ${_GNU_COMPILER_EXTENSIONS} PARENT_SCOPE)
   endif()
 
+  if(DEFINED _COMPILER_CACHE)
+    get_filename_component(compiler_cache_name "${_COMPILER_CACHE}" NAME_WE)
+    find_program(${compiler_cache_name}_exe "${_COMPILER_CACHE}")
+    if(NOT ${compiler_cache_name}_exe)
+      message(WARNING "Could not find ${_COMPILER_CACHE}, the compiler cache is disabled")
+    else()
+      set(JUCER_COMPILER_CACHE "${${compiler_cache_name}_exe}" PARENT_SCOPE)
+    endif()
+  endif()
+
   if(DEFINED _ICON_SMALL)
     if(NOT _ICON_SMALL STREQUAL "<None>")
       _FRUT_abs_path_based_on_jucer_project_dir("${_ICON_SMALL}" small_icon)
@@ -749,6 +953,46 @@ function(jucer_export_target exporter)
     set(JUCER_PKGCONFIG_LIBRARIES ${_PKGCONFIG_LIBRARIES} PARENT_SCOPE)
   endif()
 
+  if(DEFINED _PLUGIN_LOAD_TIME_OPTIMISATION)
+    set(JUCER_PLUGIN_LOAD_TIME_OPTIMISATION ${_PLUGIN_LOAD_TIME_OPTIMISATION} PARENT_SCOPE)
+  endif()
+
+  if(DEFINED _MULTI_ISA_SOURCES)
+    unset(multi_isa_sources)
+    foreach(path ${_MULTI_ISA_SOURCES})
+      _FRUT_abs_path_based_on_jucer_project_dir("${path}" path)
+      list(APPEND multi_isa_sources "${path}")
+    endforeach()
+    set(JUCER_MULTI_ISA_SOURCES ${multi_isa_sources} PARENT_SCOPE)
+
+    if(NOT DEFINED _MULTI_ISA_LEVELS)
+      set(_MULTI_ISA_LEVELS "x86-64-v2" "x86-64-v3" "x86-64-v4")
+    endif()
+  endif()
+
+  if(DEFINED _MULTI_ISA_LEVELS)
+    set(isa_levels "x86-64-v2" "x86-64-v3" "x86-64-v4")
+    foreach(level ${_MULTI_ISA_LEVELS})
+      if(NOT "${level}" IN_LIST isa_levels)
+        message(FATAL_ERROR "Unsupported value for MULTI_ISA_LEVELS: \"${level}\"\n"
+          "Supported values: ${isa_levels}"
+        )
+      endif()
+    endforeach()
+    set(JUCER_MULTI_ISA_LEVELS ${_MULTI_ISA_LEVELS} PARENT_SCOPE)
+  endif()
+
+  if(DEFINED _VECTORISATION_REPORT)
+    set(JUCER_VECTORISATION_REPORT ${_VECTORISATION_REPORT} PARENT_SCOPE)
+  endif()
+
+  if(DEFINED _VECTORISATION_REPORT_BASELINE)
+    _FRUT_abs_path_based_on_jucer_project_dir("${_VECTORISATION_REPORT_BASELINE}" path)
+    set(JUCER_VECTORISATION_REPORT_BASELINE ${path} PARENT_SCOPE)
+  endif()
+
+  _FRUT_profile_end(jucer_export_target)
+
 endfunction()
 
 
@@ -756,6 +1000,8 @@ function(jucer_export_target_configuration
   exporter NAME_KEYWORD config DEBUG_MODE_KEYWORD is_debug
 )
 
+  _FRUT_profile_begin(jucer_export_target_configuration)
+
   if(NOT "${exporter}" IN_LIST Reprojucer_supported_exporters)
     message(FATAL_ERROR "Unsupported exporter: ${exporter}\n"
       "Supported exporters: ${Reprojucer_supported_exporters}"
@@ -783,6 +1029,7 @@ function(jucer_export_target_configuration
   list(FIND Reprojucer_supported_exporters "${exporter}" exporter_index)
   list(GET Reprojucer_supported_exporters_conditions ${exporter_index} condition)
   if(NOT ${condition})
+    _FRUT_profile_end(jucer_export_target_configuration)
     return()
   endif()
 
@@ -806,6 +1053,7 @@ function(jucer_export_target_configuration
     "HEADER_SEARCH_PATHS"
     "EXTRA_LIBRARY_SEARCH_PATHS"
     "PREPROCESSOR_DEFINITIONS"
+    "COMPILER_FLAG_SCHEMES"
   )
 
   if(exporter STREQUAL "Xcode (MacOSX)")
@@ -855,6 +1103,16 @@ function(jucer_export_target_configuration
   if(exporter STREQUAL "Linux Makefile")
     list(APPEND single_value_keywords
       "ARCHITECTURE"
+      "LINK_TIME_OPTIMISATION"
+      "PROFILE_GUIDED_OPTIMISATION"
+      "LINKER"
+      "SPLIT_DWARF"
+      "COMPRESS_DEBUG_SECTIONS"
+      "SEPARATE_DEBUG_SYMBOLS"
+      "PROFILING"
+    )
+    list(APPEND multi_value_keywords
+      "PROFILE_TRAINING_COMMAND"
     )
   endif()
 
@@ -897,6 +1155,11 @@ function(jucer_export_target_configuration
     )
   endif()
 
+  if(DEFINED _COMPILER_FLAG_SCHEMES)
+    _FRUT_check_compiler_flag_schemes("${_COMPILER_FLAG_SCHEMES}")
+    set(JUCER_COMPILER_FLAG_SCHEMES_${config} "${_COMPILER_FLAG_SCHEMES}" PARENT_SCOPE)
+  endif()
+
   if(DEFINED _OPTIMISATION)
     set(optimisation ${_OPTIMISATION})
     if(exporter MATCHES "^Visual Studio 201(7|5|3)$")
@@ -1191,11 +1454,82 @@ function(jucer_export_target_configuration
     set(JUCER_ARCHITECTURE_FLAG_${config} ${architecture_flag} PARENT_SCOPE)
   endif()
 
+  if(DEFINED _LINKER)
+    set(linker ${_LINKER})
+    if(linker STREQUAL "lld")
+      set(linker_program_names "ld.lld")
+    elseif(linker STREQUAL "gold")
+      set(linker_program_names "ld.gold")
+    elseif(linker STREQUAL "mold")
+      set(linker_program_names "ld.mold" "mold")
+    elseif(NOT linker STREQUAL "default")
+      message(FATAL_ERROR "Unsupported value for LINKER: \"${linker}\"")
+    endif()
+    if(NOT linker STREQUAL "default")
+      find_program(${linker}_linker_exe NAMES ${linker_program_names})
+      if(NOT ${linker}_linker_exe)
+        message(WARNING "Could not find ${linker}, the ${config} configuration will use the "
+          "default linker"
+        )
+        set(linker "default")
+      endif()
+    endif()
+    set(JUCER_LINKER_${config} ${linker} PARENT_SCOPE)
+  endif()
+
+  if(DEFINED _SPLIT_DWARF)
+    set(JUCER_SPLIT_DWARF_${config} ${_SPLIT_DWARF} PARENT_SCOPE)
+  endif()
+
+  if(DEFINED _COMPRESS_DEBUG_SECTIONS)
+    set(JUCER_COMPRESS_DEBUG_SECTIONS_${config} ${_COMPRESS_DEBUG_SECTIONS} PARENT_SCOPE)
+  endif()
+
+  if(DEFINED _SEPARATE_DEBUG_SYMBOLS)
+    set(JUCER_SEPARATE_DEBUG_SYMBOLS_${config} ${_SEPARATE_DEBUG_SYMBOLS} PARENT_SCOPE)
+  endif()
+
+  if(DEFINED _PROFILE_GUIDED_OPTIMISATION)
+    if(_PROFILE_GUIDED_OPTIMISATION AND NOT DEFINED _PROFILE_TRAINING_COMMAND)
+      message(FATAL_ERROR "PROFILE_GUIDED_OPTIMISATION requires PROFILE_TRAINING_COMMAND")
+    endif()
+    set(JUCER_PROFILE_GUIDED_OPTIMISATION_${config} ${_PROFILE_GUIDED_OPTIMISATION}
+      PARENT_SCOPE
+    )
+  endif()
+
+  if(DEFINED _PROFILE_TRAINING_COMMAND)
+    set(JUCER_PROFILE_TRAINING_COMMAND_${config} ${_PROFILE_TRAINING_COMMAND} PARENT_SCOPE)
+  endif()
+
+  if(DEFINED _PROFILING)
+    set(profiling ${_PROFILING})
+    if(NOT profiling MATCHES "^(perf|instrument-functions|gprof)$")
+      message(FATAL_ERROR "Unsupported value for PROFILING: \"${profiling}\"")
+    endif()
+    set(JUCER_PROFILING_${config} ${profiling} PARENT_SCOPE)
+    # Profile optimised code by default, OPTIMISATION takes precedence when given
+    if(NOT DEFINED _OPTIMISATION)
+      set(JUCER_OPTIMISATION_FLAG_${config} "-O2" PARENT_SCOPE)
+    endif()
+  endif()
+
+  _FRUT_profile_end(jucer_export_target_configuration "${config}")
+
 endfunction()
 
 
 function(jucer_project_end)
 
+  _FRUT_profile_begin(jucer_project_end)
+
+  # jucer_project_files() collects the files in global properties, see the comment there
+  foreach(list_name SOURCES RESOURCES XCODE_RESOURCES)
+    get_property(files GLOBAL PROPERTY FRUT_PROJECT_FILES_${list_name})
+    set(JUCER_PROJECT_${list_name} ${files} ${JUCER_PROJECT_${list_name}})
+    set_property(GLOBAL PROPERTY FRUT_PROJECT_FILES_${list_name} "")
+  endforeach()
+
   unset(current_exporter)
   foreach(exporter_index RANGE 4)
     list(GET Reprojucer_supported_exporters_conditions ${exporter_index} condition)
@@ -1251,8 +1585,34 @@ function(jucer_project_end)
 
   set(CMAKE_CONFIGURATION_TYPES ${JUCER_PROJECT_CONFIGURATIONS} PARENT_SCOPE)
 
+  if(current_exporter STREQUAL "Linux Makefile")
+    foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+      if(JUCER_LINK_TIME_OPTIMISATION_${config})
+        # Archiving LTO objects (e.g. into the Shared Code target) requires the archiver
+        # and ranlib wrappers that load the LTO plugin of the compiler
+        if(CMAKE_CXX_COMPILER_AR)
+          set(CMAKE_AR "${CMAKE_CXX_COMPILER_AR}" PARENT_SCOPE)
+        endif()
+        if(CMAKE_CXX_COMPILER_RANLIB)
+          set(CMAKE_RANLIB "${CMAKE_CXX_COMPILER_RANLIB}" PARENT_SCOPE)
+        endif()
+        break()
+      endif()
+    endforeach()
+  endif()
+
+  set(FRUT_TOOLS_AS_TARGET OFF CACHE BOOL
+    "Build frut-tools with the project, and generate BinaryData and icons when building"
+  )
+  set(FRUT_BUILD_TELEMETRY OFF CACHE BOOL
+    "Record the duration and peak memory of the build steps, and add frut_build_report"
+  )
+
   _FRUT_generate_AppConfig_header()
   _FRUT_generate_JuceHeader_header()
+  if(DEFINED JUCER_MULTI_ISA_SOURCES)
+    _FRUT_generate_IsaDispatch_header()
+  endif()
 
   if(DEFINED JUCER_SMALL_ICON OR DEFINED JUCER_LARGE_ICON)
     if(APPLE)
@@ -1289,7 +1649,7 @@ function(jucer_project_end)
   endif()
 
   source_group("Juce Library Code"
-    REGULAR_EXPRESSION "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode/*"
+    REGULAR_EXPRESSION "${JUCER_LIBRARY_CODE_DIR}/*"
   )
 
   set_source_files_properties(
@@ -1298,6 +1658,8 @@ function(jucer_project_end)
     PROPERTIES HEADER_FILE_ONLY TRUE
   )
 
+  _FRUT_set_compiler_flag_scheme_properties()
+
   if(DEFINED JUCER_COMPANY_COPYRIGHT
       OR NOT(DEFINED JUCER_VERSION AND JUCER_VERSION VERSION_LESS 5.2.0))
     set(ns_human_readable_copyright "${JUCER_COMPANY_COPYRIGHT}")
@@ -1331,57 +1693,36 @@ function(jucer_project_end)
   )
 
   if(JUCER_CUSTOM_PLIST)
-    set(PListMerger_version "0.1.0")
-    find_program(PListMerger_exe "PListMerger-${PListMerger_version}"
-      PATHS "${Reprojucer.cmake_DIR}/bin"
-      NO_DEFAULT_PATH
-    )
-    if(NOT PListMerger_exe)
-      message(STATUS "Building PListMerger")
-      try_compile(PListMerger
-        "${Reprojucer.cmake_DIR}/PListMerger/_build/${CMAKE_GENERATOR}"
-        "${Reprojucer.cmake_DIR}/PListMerger"
-        PListMerger install
-        CMAKE_FLAGS
-        "-DJUCE_modules_DIRS=${JUCER_PROJECT_MODULES_FOLDERS}"
-        "-DCMAKE_INSTALL_PREFIX=${Reprojucer.cmake_DIR}/bin"
-      )
-      if(NOT PListMerger)
-        message(FATAL_ERROR "Failed to build PListMerger")
-      endif()
-      message(STATUS "PListMerger has been successfully built")
-      find_program(PListMerger_exe "PListMerger-${PListMerger_version}"
-        PATHS "${Reprojucer.cmake_DIR}/bin"
-        NO_DEFAULT_PATH
-      )
-      if(NOT PListMerger_exe)
-        message(FATAL_ERROR "Could not find PListMerger-${PListMerger_version}")
-      endif()
-    endif()
+    _FRUT_profile_begin(plist-merge)
+    _FRUT_get_frut_tools_exe(frut_tools_exe)
 
     execute_process(
       COMMAND
-      "${PListMerger_exe}"
+      "${frut_tools_exe}" "plist-merge"
       "${JUCER_CUSTOM_PLIST}"
       "<plist><dict>${main_plist_entries}</dict></plist>"
-      OUTPUT_VARIABLE PListMerger_output
+      OUTPUT_VARIABLE plist_merge_output
       OUTPUT_STRIP_TRAILING_WHITESPACE
-      RESULT_VARIABLE PListMerger_return_code
+      RESULT_VARIABLE plist_merge_return_code
     )
-    if(NOT PListMerger_return_code EQUAL 0)
-      message(FATAL_ERROR "Error when executing PListMerger")
+    if(NOT plist_merge_return_code EQUAL 0)
+      message(FATAL_ERROR "Error when executing frut-tools plist-merge")
     endif()
 
     if(WIN32)
-      string(REPLACE "\r\n" "\n" PListMerger_output "${PListMerger_output}")
+      string(REPLACE "\r\n" "\n" plist_merge_output "${plist_merge_output}")
     endif()
-    string(REPLACE "<plist>\n  <dict>" "" PListMerger_output "${PListMerger_output}")
-    string(REPLACE "\n  </dict>\n</plist>" "" PListMerger_output "${PListMerger_output}")
-    set(main_plist_entries "${PListMerger_output}")
+    string(REPLACE "<plist>\n  <dict>" "" plist_merge_output "${plist_merge_output}")
+    string(REPLACE "\n  </dict>\n</plist>" "" plist_merge_output "${plist_merge_output}")
+    set(main_plist_entries "${plist_merge_output}")
+    _FRUT_profile_end(plist-merge)
   endif()
 
   string(REGEX REPLACE "[^A-Za-z0-9_.+-]" "_" target "${JUCER_PROJECT_NAME}")
 
+  _FRUT_get_project_settings_target(settings_target)
+  _FRUT_add_project_settings_target(${settings_target})
+
   if(NOT APPLE)
     unset(JUCER_PROJECT_XCODE_RESOURCES)
   endif()
@@ -1398,7 +1739,11 @@ function(jucer_project_end)
     ${resources_rc_file}
   )
 
+  _FRUT_profile_begin(targets)
+
   if(JUCER_PROJECT_TYPE STREQUAL "Console Application")
+    _FRUT_use_heavy_compile_job_pool(${target} all_sources)
+    _FRUT_add_multi_isa_variants(${target} all_sources)
     add_executable(${target} ${all_sources})
     _FRUT_set_output_directory_properties(${target} "ConsoleApp")
     _FRUT_set_common_target_properties(${target})
@@ -1406,6 +1751,8 @@ function(jucer_project_end)
     _FRUT_set_custom_xcode_flags(${target})
 
   elseif(JUCER_PROJECT_TYPE STREQUAL "GUI Application")
+    _FRUT_use_heavy_compile_job_pool(${target} all_sources)
+    _FRUT_add_multi_isa_variants(${target} all_sources)
     add_executable(${target} WIN32 MACOSX_BUNDLE ${all_sources})
 
     if(JUCER_DOCUMENT_FILE_EXTENSIONS)
@@ -1453,12 +1800,16 @@ function(jucer_project_end)
     _FRUT_set_custom_xcode_flags(${target})
 
   elseif(JUCER_PROJECT_TYPE STREQUAL "Static Library")
+    _FRUT_use_heavy_compile_job_pool(${target} all_sources)
+    _FRUT_add_multi_isa_variants(${target} all_sources)
     add_library(${target} STATIC ${all_sources})
     _FRUT_set_output_directory_properties(${target} "Static Library")
     _FRUT_set_common_target_properties(${target})
     _FRUT_set_custom_xcode_flags(${target})
 
   elseif(JUCER_PROJECT_TYPE STREQUAL "Dynamic Library")
+    _FRUT_use_heavy_compile_job_pool(${target} all_sources)
+    _FRUT_add_multi_isa_variants(${target} all_sources)
     add_library(${target} SHARED ${all_sources})
     _FRUT_set_output_directory_properties(${target} "Dynamic Library")
     _FRUT_set_common_target_properties(${target})
@@ -1466,6 +1817,8 @@ function(jucer_project_end)
 
   elseif(JUCER_PROJECT_TYPE STREQUAL "Audio Plug-in")
     if(NOT APPLE AND DEFINED JUCER_VERSION AND JUCER_VERSION VERSION_LESS 5.0.0)
+      _FRUT_use_heavy_compile_job_pool(${target} all_sources)
+      _FRUT_add_multi_isa_variants(${target} all_sources)
       add_library(${target} MODULE ${all_sources})
       set_target_properties(${target} PROPERTIES PREFIX "")
       _FRUT_set_output_directory_properties(${target} "")
@@ -1511,6 +1864,8 @@ function(jucer_project_end)
       endforeach()
 
       set(shared_code_target ${target}_Shared_Code)
+      _FRUT_use_heavy_compile_job_pool(${shared_code_target} SharedCode_sources)
+      _FRUT_add_multi_isa_variants(${shared_code_target} SharedCode_sources)
       add_library(${shared_code_target} STATIC
         ${SharedCode_sources}
         ${JUCER_PROJECT_RESOURCES}
@@ -1527,6 +1882,8 @@ function(jucer_project_end)
 
       if(JUCER_BUILD_VST)
         set(vst_target ${target}_VST)
+        _FRUT_use_heavy_compile_job_pool(${vst_target} VST_sources)
+        _FRUT_add_multi_isa_variants(${vst_target} VST_sources)
         add_library(${vst_target} MODULE
           ${VST_sources}
           ${JUCER_PROJECT_XCODE_RESOURCES}
@@ -1563,6 +1920,8 @@ function(jucer_project_end)
 
       if(JUCER_BUILD_VST3 AND (APPLE OR MSVC))
         set(vst3_target ${target}_VST3)
+        _FRUT_use_heavy_compile_job_pool(${vst3_target} VST3_sources)
+        _FRUT_add_multi_isa_variants(${vst3_target} VST3_sources)
         add_library(${vst3_target} MODULE
           ${VST3_sources}
           ${JUCER_PROJECT_XCODE_RESOURCES}
@@ -1602,6 +1961,8 @@ function(jucer_project_end)
 
       if(JUCER_BUILD_AUDIOUNIT AND APPLE)
         set(au_target ${target}_AU)
+        _FRUT_use_heavy_compile_job_pool(${au_target} AudioUnit_sources)
+        _FRUT_add_multi_isa_variants(${au_target} AudioUnit_sources)
         add_library(${au_target} MODULE
           ${AudioUnit_sources}
           ${JUCER_PROJECT_XCODE_RESOURCES}
@@ -1652,6 +2013,8 @@ function(jucer_project_end)
 
       if(JUCER_BUILD_AUDIOUNIT_V3 AND APPLE)
         set(auv3_target ${target}_AUv3_AppExtension)
+        _FRUT_use_heavy_compile_job_pool(${auv3_target} AudioUnitv3_sources)
+        _FRUT_add_multi_isa_variants(${auv3_target} AudioUnitv3_sources)
         add_library(${auv3_target} MODULE
           ${AudioUnitv3_sources}
           ${JUCER_PROJECT_XCODE_RESOURCES}
@@ -1756,6 +2119,8 @@ function(jucer_project_end)
         else()
           set(standalone_target ${target}_StandalonePlugin)
         endif()
+        _FRUT_use_heavy_compile_job_pool(${standalone_target} Standalone_sources)
+        _FRUT_add_multi_isa_variants(${standalone_target} Standalone_sources)
         add_executable(${standalone_target} WIN32 MACOSX_BUNDLE
           ${Standalone_sources}
           ${JUCER_PROJECT_XCODE_RESOURCES}
@@ -1801,6 +2166,24 @@ function(jucer_project_end)
 
   endif()
 
+  _FRUT_profile_end(targets)
+
+  if(current_exporter STREQUAL "Linux Makefile")
+    _FRUT_add_profile_guided_optimisation_training_target(${target})
+    _FRUT_add_vectorisation_report_target(${target})
+  endif()
+
+  if(FRUT_BUILD_TELEMETRY)
+    _FRUT_add_build_report_target(${target})
+  endif()
+
+  if(FRUT_COMPILE_TIME_REPORT)
+    _FRUT_add_compile_time_report_target(${target})
+  endif()
+
+  _FRUT_profile_end(jucer_project_end)
+  _FRUT_write_configure_profile()
+
 endfunction()
 
 
@@ -1872,58 +2255,462 @@ function(_FRUT_abs_path_based_on_jucer_project_dir in_path out_path)
 endfunction()
 
 
-function(_FRUT_generate_AppConfig_header)
+function(_FRUT_check_compiler_flag_schemes schemes_and_flags)
 
-  if(DEFINED JUCER_APPCONFIG_USER_CODE_SECTION)
-    set(user_code_section "\n${JUCER_APPCONFIG_USER_CODE_SECTION}\n")
-    if("${user_code_section}" STREQUAL "\n\n")
-      set(user_code_section "\n")
-    endif()
-  else()
-    string(CONCAT user_code_section "\n\n// (You can call jucer_appconfig_header() to "
-      "add your own code to this section)\n\n"
+  list(LENGTH schemes_and_flags length)
+  math(EXPR remainder "${length} % 2")
+  if(NOT remainder EQUAL 0)
+    message(FATAL_ERROR "COMPILER_FLAG_SCHEMES expects pairs of <scheme> <flags>, got: "
+      "${schemes_and_flags}"
     )
   endif()
 
-  if(DEFINED JUCER_DISPLAY_THE_JUCE_SPLASH_SCREEN
-      AND NOT JUCER_DISPLAY_THE_JUCE_SPLASH_SCREEN)
-    set(display_splash_screen 0)
-  else()
-    set(display_splash_screen 1)
-  endif()
-  if(DEFINED JUCER_REPORT_JUCE_APP_USAGE AND NOT JUCER_REPORT_JUCE_APP_USAGE)
-    set(report_app_usage 0)
-  else()
-    set(report_app_usage 1)
-  endif()
-  if(DEFINED JUCER_SPLASH_SCREEN_COLOUR
-      AND NOT JUCER_SPLASH_SCREEN_COLOUR STREQUAL "Dark")
-    set(use_dark_splash_screen 0)
-  else()
-    set(use_dark_splash_screen 1)
-  endif()
+endfunction()
 
-  set(max_right_padding 0)
-  foreach(module_name ${JUCER_PROJECT_MODULES})
-    string(LENGTH "${module_name}" module_name_length)
-    if(module_name_length GREATER max_right_padding)
-      set(max_right_padding ${module_name_length})
+
+function(_FRUT_get_compiler_flag_scheme_flags schemes_and_flags scheme out_flags)
+
+  unset(${out_flags} PARENT_SCOPE)
+  list(LENGTH schemes_and_flags length)
+  set(index 0)
+  while(index LESS length)
+    list(GET schemes_and_flags ${index} current_scheme)
+    math(EXPR index "${index} + 1")
+    if(current_scheme STREQUAL scheme)
+      list(GET schemes_and_flags ${index} flags)
+      set(${out_flags} "${flags}" PARENT_SCOPE)
     endif()
-  endforeach()
-  math(EXPR max_right_padding "${max_right_padding} + 5")
+    math(EXPR index "${index} + 1")
+  endwhile()
 
-  unset(module_available_defines)
-  unset(config_flags_defines)
-  foreach(module_name ${JUCER_PROJECT_MODULES})
-    string(LENGTH "${module_name}" right_padding)
-    unset(padding_spaces)
-    while(right_padding LESS max_right_padding)
-      string(APPEND padding_spaces " ")
-      math(EXPR right_padding "${right_padding} + 1")
-    endwhile()
-    string(APPEND module_available_defines
-      "#define JUCE_MODULE_AVAILABLE_${module_name}${padding_spaces} 1\n"
-    )
+endfunction()
+
+
+function(_FRUT_profile_begin name)
+
+  if(NOT FRUT_PROFILE_CONFIGURE)
+    return()
+  endif()
+
+  string(TIMESTAMP now "%s%f")
+  set_property(GLOBAL APPEND PROPERTY FRUT_PROFILE_STACK "${name}|${now}")
+
+endfunction()
+
+
+function(_FRUT_profile_end name)
+
+  if(NOT FRUT_PROFILE_CONFIGURE)
+    return()
+  endif()
+
+  string(TIMESTAMP now "%s%f")
+  get_property(stack GLOBAL PROPERTY FRUT_PROFILE_STACK)
+  list(LENGTH stack stack_length)
+  if(stack_length EQUAL 0)
+    message(FATAL_ERROR "_FRUT_profile_end(${name}) without _FRUT_profile_begin()")
+  endif()
+  list(GET stack -1 top)
+  list(REMOVE_AT stack -1)
+  set_property(GLOBAL PROPERTY FRUT_PROFILE_STACK "${stack}")
+  string(REPLACE "|" ";" top "${top}")
+  list(GET top 0 begin_name)
+  list(GET top 1 begin_time)
+  if(NOT begin_name STREQUAL name)
+    message(FATAL_ERROR "_FRUT_profile_end(${name}) doesn't match "
+      "_FRUT_profile_begin(${begin_name})"
+    )
+  endif()
+
+  math(EXPR duration "${now} - ${begin_time}")
+  # The optional second argument (e.g. the module name) only appears in the trace, so
+  # that the summary adds up all the calls of a function
+  set(detail "")
+  if(ARGC GREATER 1)
+    set(detail "${ARGV1}")
+  endif()
+  set_property(GLOBAL APPEND PROPERTY FRUT_PROFILE_EVENTS
+    "${name}|${detail}|${begin_time}|${duration}"
+  )
+
+endfunction()
+
+
+function(_FRUT_write_configure_profile)
+
+  if(NOT FRUT_PROFILE_CONFIGURE)
+    return()
+  endif()
+
+  get_property(origin GLOBAL PROPERTY FRUT_PROFILE_ORIGIN)
+  get_property(events GLOBAL PROPERTY FRUT_PROFILE_EVENTS)
+
+  unset(trace_events)
+  unset(names)
+  foreach(event ${events})
+    string(REPLACE "|" ";" event "${event}")
+    list(GET event 0 name)
+    list(GET event 1 detail)
+    list(GET event 2 begin_time)
+    list(GET event 3 duration)
+
+    math(EXPR ts "${begin_time} - ${origin}")
+    string(REPLACE "\\" "\\\\" json_detail "${detail}")
+    string(REPLACE "\"" "\\\"" json_detail "${json_detail}")
+    if(trace_events)
+      string(APPEND trace_events ",")
+    endif()
+    string(APPEND trace_events "\n    {\"name\": \"${name}\", \"cat\": \"FRUT\", "
+      "\"ph\": \"X\", \"ts\": ${ts}, \"dur\": ${duration}, \"pid\": 1, \"tid\": 1, "
+      "\"args\": {\"detail\": \"${json_detail}\"}}"
+    )
+
+    string(MAKE_C_IDENTIFIER "${name}" name_id)
+    if(NOT DEFINED total_${name_id})
+      list(APPEND names "${name}")
+      set(total_${name_id} 0)
+      set(calls_${name_id} 0)
+    endif()
+    math(EXPR total_${name_id} "${total_${name_id}} + ${duration}")
+    math(EXPR calls_${name_id} "${calls_${name_id}} + 1")
+  endforeach()
+
+  set(trace_file "${CMAKE_CURRENT_BINARY_DIR}/FRUT-configure-trace.json")
+  file(WRITE "${trace_file}"
+    "{\n  \"displayTimeUnit\": \"ms\",\n  \"traceEvents\": [${trace_events}\n  ]\n}\n"
+  )
+
+  unset(totals)
+  foreach(name ${names})
+    string(MAKE_C_IDENTIFIER "${name}" name_id)
+    list(APPEND totals "${total_${name_id}}|${name}")
+  endforeach()
+  list(SORT totals COMPARE NATURAL ORDER DESCENDING)
+
+  set(summary "   total (ms)   calls   average (ms)   step\n")
+  foreach(total ${totals})
+    string(REPLACE "|" ";" total "${total}")
+    list(GET total 0 duration)
+    list(GET total 1 name)
+    string(MAKE_C_IDENTIFIER "${name}" name_id)
+    math(EXPR average "${duration} / ${calls_${name_id}}")
+    unset(columns)
+    set(calls "${calls_${name_id}}")
+    foreach(value_and_width "${duration}|ms|13" "${calls}||8" "${average}|ms|15")
+      string(REPLACE "|" ";" value_and_width "${value_and_width}")
+      list(GET value_and_width 0 value)
+      list(GET value_and_width 1 unit)
+      list(GET value_and_width 2 width)
+      if(unit STREQUAL "ms")
+        # Microseconds to milliseconds, with 3 decimals
+        math(EXPR milliseconds "${value} / 1000")
+        math(EXPR fraction "${value} % 1000 + 1000")
+        string(SUBSTRING "${fraction}" 1 3 fraction)
+        set(value "${milliseconds}.${fraction}")
+      endif()
+      string(LENGTH "${value}" length)
+      while(length LESS width)
+        string(PREPEND value " ")
+        math(EXPR length "${length} + 1")
+      endwhile()
+      string(APPEND columns "${value}")
+    endforeach()
+    string(APPEND summary "${columns}   ${name}\n")
+  endforeach()
+
+  set(summary_file "${CMAKE_CURRENT_BINARY_DIR}/FRUT-configure-summary.txt")
+  file(WRITE "${summary_file}" "${summary}")
+  message(STATUS "Configure profile written to ${trace_file} and ${summary_file}")
+
+endfunction()
+
+
+function(_FRUT_get_frut_tools_exe out_exe)
+
+  # frut-tools is built at most once per configure run
+  get_property(frut_tools_exe GLOBAL PROPERTY FRUT_TOOLS_EXE)
+  if(frut_tools_exe)
+    set(${out_exe} "${frut_tools_exe}" PARENT_SCOPE)
+    return()
+  endif()
+
+  if(NOT DEFINED FRUT_TOOLS_CACHE_DIR)
+    if(DEFINED ENV{XDG_CACHE_HOME})
+      set(default_cache_dir "$ENV{XDG_CACHE_HOME}/FRUT")
+    elseif(CMAKE_HOST_WIN32 AND DEFINED ENV{LOCALAPPDATA})
+      set(default_cache_dir "$ENV{LOCALAPPDATA}/FRUT")
+    elseif(CMAKE_HOST_APPLE AND DEFINED ENV{HOME})
+      set(default_cache_dir "$ENV{HOME}/Library/Caches/FRUT")
+    elseif(DEFINED ENV{HOME})
+      set(default_cache_dir "$ENV{HOME}/.cache/FRUT")
+    else()
+      set(default_cache_dir "${CMAKE_BINARY_DIR}/FRUT")
+    endif()
+    file(TO_CMAKE_PATH "${default_cache_dir}" default_cache_dir)
+  endif()
+  set(FRUT_TOOLS_CACHE_DIR "${default_cache_dir}" CACHE PATH
+    "Directory where the frut-tools executables are built and shared between projects"
+  )
+
+  _FRUT_get_frut_tools_modules(frut_tools_modules JUCE_modules_DIR)
+
+  # The executable is identified by everything it is built from, so that it is rebuilt
+  # when one of them changes, and shared by all the projects where they are the same
+  set(frut_tools_version "0.1.0")
+  _FRUT_profile_begin(frut-tools-hash)
+  _FRUT_get_directory_contents_hash("${Reprojucer.cmake_DIR}/frut-tools" tools_hash)
+  _FRUT_get_frut_tools_modules_hashes("${frut_tools_modules}" "${JUCE_modules_DIR}"
+    modules_hashes
+  )
+  set(frut_tools_inputs
+    "frut-tools ${frut_tools_version}\n${tools_hash}\n${modules_hashes}"
+    "${CMAKE_CXX_COMPILER_ID} ${CMAKE_CXX_COMPILER_VERSION} ${CMAKE_CXX_COMPILER}\n"
+    "${CMAKE_SYSTEM_NAME} ${CMAKE_SYSTEM_PROCESSOR} ${CMAKE_OSX_ARCHITECTURES}\n"
+    "Release"
+  )
+  string(SHA256 frut_tools_key "${frut_tools_inputs}")
+  string(SUBSTRING "${frut_tools_key}" 0 16 frut_tools_key)
+  _FRUT_profile_end(frut-tools-hash)
+  set(frut_tools_name "frut-tools-${frut_tools_version}-${frut_tools_key}")
+  if(CMAKE_HOST_WIN32)
+    set(frut_tools_exe "${FRUT_TOOLS_CACHE_DIR}/${frut_tools_name}.exe")
+  else()
+    set(frut_tools_exe "${FRUT_TOOLS_CACHE_DIR}/${frut_tools_name}")
+  endif()
+
+  if(NOT EXISTS "${frut_tools_exe}")
+    # Concurrent configures that need the same executable wait for the first one to
+    # build it, instead of building it at the same time
+    set(build_dir "${FRUT_TOOLS_CACHE_DIR}/_build/${frut_tools_name}")
+    file(MAKE_DIRECTORY "${FRUT_TOOLS_CACHE_DIR}/_build")
+    file(LOCK "${build_dir}.lock" GUARD FUNCTION TIMEOUT 3600
+      RESULT_VARIABLE lock_result
+    )
+    if(NOT lock_result EQUAL 0)
+      # Without the lock, another configure could be building in the shared directory
+      message(WARNING "Could not lock ${build_dir}.lock: ${lock_result}\n"
+        "frut-tools is built in the binary directory instead"
+      )
+      set(build_dir "${CMAKE_BINARY_DIR}/CMakeFiles/FRUT/_build/${frut_tools_name}")
+    endif()
+  endif()
+
+  if(NOT EXISTS "${frut_tools_exe}")
+    message(STATUS "Building frut-tools in ${FRUT_TOOLS_CACHE_DIR}")
+    _FRUT_profile_begin(frut-tools-build)
+    # frut-tools is always built in Release, even with multi-configuration generators
+    set(CMAKE_TRY_COMPILE_CONFIGURATION "Release")
+    try_compile(frut_tools
+      "${build_dir}"
+      "${Reprojucer.cmake_DIR}/frut-tools"
+      frut-tools install
+      CMAKE_FLAGS
+      "-DJUCE_modules_DIRS=${JUCE_modules_DIR}"
+      "-DCMAKE_BUILD_TYPE=Release"
+      "-DCMAKE_INSTALL_PREFIX=${build_dir}-install"
+      OUTPUT_VARIABLE frut_tools_output
+    )
+    if(NOT frut_tools)
+      message("${frut_tools_output}")
+      message(FATAL_ERROR "Failed to build frut-tools")
+    endif()
+    file(GLOB installed_exe "${build_dir}-install/frut-tools-${frut_tools_version}*")
+    if(NOT installed_exe)
+      message(FATAL_ERROR "Could not find frut-tools-${frut_tools_version}")
+    endif()
+    # Renaming is atomic, so other configures never see a partially written executable
+    file(RENAME "${installed_exe}" "${frut_tools_exe}")
+    file(REMOVE_RECURSE "${build_dir}" "${build_dir}-install")
+    message(STATUS "frut-tools has been successfully built")
+    _FRUT_profile_end(frut-tools-build)
+  endif()
+
+  set_property(GLOBAL PROPERTY FRUT_TOOLS_EXE "${frut_tools_exe}")
+  set(${out_exe} "${frut_tools_exe}" PARENT_SCOPE)
+
+endfunction()
+
+
+function(_FRUT_get_frut_tools_modules out_modules out_modules_dir)
+
+  set(frut_tools_modules
+    juce_core juce_cryptography juce_data_structures juce_events juce_graphics
+    juce_gui_basics juce_gui_extra
+  )
+  foreach(modules_folder ${JUCER_PROJECT_MODULES_FOLDERS})
+    set(has_all_modules TRUE)
+    foreach(module_name ${frut_tools_modules})
+      if(NOT EXISTS "${modules_folder}/${module_name}/${module_name}.h")
+        set(has_all_modules FALSE)
+        break()
+      endif()
+    endforeach()
+    if(has_all_modules)
+      set(${out_modules} ${frut_tools_modules} PARENT_SCOPE)
+      set(${out_modules_dir} "${modules_folder}" PARENT_SCOPE)
+      return()
+    endif()
+  endforeach()
+
+  string(REPLACE ";" ", " modules "${frut_tools_modules}")
+  message(FATAL_ERROR "Could not find ${modules} when searching in the following "
+    "directories: ${JUCER_PROJECT_MODULES_FOLDERS}"
+  )
+
+endfunction()
+
+
+function(_FRUT_add_frut_tools_target)
+
+  if(TARGET frut-tools)
+    return()
+  endif()
+
+  _FRUT_get_frut_tools_modules(frut_tools_modules JUCE_modules_DIRS)
+  add_subdirectory("${Reprojucer.cmake_DIR}/frut-tools"
+    "${CMAKE_BINARY_DIR}/frut-tools" EXCLUDE_FROM_ALL
+  )
+
+endfunction()
+
+
+function(_FRUT_get_frut_tools_modules_hashes modules modules_dir out_hashes)
+
+  # Hashing the contents of the JUCE modules takes a while, so the hashes are kept in the
+  # binary directory. They are computed again when the header of a module changes (it
+  # contains the version of the module), or when files are added to or removed from one
+  # of its folders, which changes the timestamp of the folder.
+  set(hashes_file "${CMAKE_BINARY_DIR}/CMakeFiles/FRUT/frut-tools-modules.txt")
+  set(hashes_key "2 ${modules_dir}")
+  foreach(module_name ${modules})
+    file(SHA1 "${modules_dir}/${module_name}/${module_name}.h" module_header_hash)
+    string(APPEND hashes_key " ${module_header_hash}")
+  endforeach()
+
+  # The first line is the key, the second line lists the folders of the modules, and
+  # each other line is "<module_name> <hash>"
+  if(EXISTS "${hashes_file}")
+    file(STRINGS "${hashes_file}" hashes_lines)
+    list(LENGTH hashes_lines hashes_lines_count)
+    if(hashes_lines_count GREATER 2)
+      list(GET hashes_lines 0 cached_key)
+      list(GET hashes_lines 1 modules_folders)
+      string(REPLACE "|" ";" modules_folders "${modules_folders}")
+      _FRUT_get_folders_timestamps_hash("${modules_folders}" folders_hash)
+      if(cached_key STREQUAL "${hashes_key} ${folders_hash}")
+        list(REMOVE_AT hashes_lines 0 1)
+        string(REPLACE ";" "\n" hashes "${hashes_lines}")
+        set(${out_hashes} "${hashes}\n" PARENT_SCOPE)
+        return()
+      endif()
+    endif()
+  endif()
+
+  set(hashes "")
+  set(modules_folders "")
+  foreach(module_name ${modules})
+    _FRUT_get_directory_contents_hash("${modules_dir}/${module_name}" module_hash
+      module_folders
+    )
+    string(APPEND hashes "${module_name} ${module_hash}\n")
+    list(APPEND modules_folders "${modules_dir}/${module_name}" ${module_folders})
+  endforeach()
+
+  _FRUT_get_folders_timestamps_hash("${modules_folders}" folders_hash)
+  string(REPLACE ";" "|" modules_folders_line "${modules_folders}")
+  file(WRITE "${hashes_file}"
+    "${hashes_key} ${folders_hash}\n${modules_folders_line}\n${hashes}"
+  )
+  set(${out_hashes} "${hashes}" PARENT_SCOPE)
+
+endfunction()
+
+
+function(_FRUT_get_directory_contents_hash directory out_hash)
+
+  file(GLOB_RECURSE entries LIST_DIRECTORIES true RELATIVE "${directory}"
+    "${directory}/*"
+  )
+  list(SORT entries)
+
+  set(contents "")
+  set(folders "")
+  foreach(entry ${entries})
+    if(entry MATCHES "(^|/)_build(/|$)")
+      continue()
+    endif()
+    if(IS_DIRECTORY "${directory}/${entry}")
+      list(APPEND folders "${directory}/${entry}")
+      continue()
+    endif()
+    file(SHA256 "${directory}/${entry}" file_hash)
+    string(APPEND contents "${entry} ${file_hash}\n")
+  endforeach()
+
+  string(SHA256 contents_hash "${contents}")
+  set(${out_hash} "${contents_hash}" PARENT_SCOPE)
+  # The optional third argument receives the folders of the directory
+  if(ARGC GREATER 2)
+    set(${ARGV2} "${folders}" PARENT_SCOPE)
+  endif()
+
+endfunction()
+
+
+function(_FRUT_generate_AppConfig_header)
+
+  _FRUT_profile_begin(_FRUT_generate_AppConfig_header)
+
+  if(DEFINED JUCER_APPCONFIG_USER_CODE_SECTION)
+    set(user_code_section "\n${JUCER_APPCONFIG_USER_CODE_SECTION}\n")
+    if("${user_code_section}" STREQUAL "\n\n")
+      set(user_code_section "\n")
+    endif()
+  else()
+    string(CONCAT user_code_section "\n\n// (You can call jucer_appconfig_header() to "
+      "add your own code to this section)\n\n"
+    )
+  endif()
+
+  if(DEFINED JUCER_DISPLAY_THE_JUCE_SPLASH_SCREEN
+      AND NOT JUCER_DISPLAY_THE_JUCE_SPLASH_SCREEN)
+    set(display_splash_screen 0)
+  else()
+    set(display_splash_screen 1)
+  endif()
+  if(DEFINED JUCER_REPORT_JUCE_APP_USAGE AND NOT JUCER_REPORT_JUCE_APP_USAGE)
+    set(report_app_usage 0)
+  else()
+    set(report_app_usage 1)
+  endif()
+  if(DEFINED JUCER_SPLASH_SCREEN_COLOUR
+      AND NOT JUCER_SPLASH_SCREEN_COLOUR STREQUAL "Dark")
+    set(use_dark_splash_screen 0)
+  else()
+    set(use_dark_splash_screen 1)
+  endif()
+
+  set(max_right_padding 0)
+  foreach(module_name ${JUCER_PROJECT_MODULES})
+    string(LENGTH "${module_name}" module_name_length)
+    if(module_name_length GREATER max_right_padding)
+      set(max_right_padding ${module_name_length})
+    endif()
+  endforeach()
+  math(EXPR max_right_padding "${max_right_padding} + 5")
+
+  unset(module_available_defines)
+  unset(config_flags_defines)
+  foreach(module_name ${JUCER_PROJECT_MODULES})
+    string(LENGTH "${module_name}" right_padding)
+    unset(padding_spaces)
+    while(right_padding LESS max_right_padding)
+      string(APPEND padding_spaces " ")
+      math(EXPR right_padding "${right_padding} + 1")
+    endwhile()
+    string(APPEND module_available_defines
+      "#define JUCE_MODULE_AVAILABLE_${module_name}${padding_spaces} 1\n"
+    )
 
     if(DEFINED JUCER_${module_name}_CONFIG_FLAGS)
       string(APPEND config_flags_defines
@@ -2118,48 +2905,28 @@ function(_FRUT_generate_AppConfig_header)
   else()
     set(template_file "${Reprojucer_templates_DIR}/AppConfig.h")
   endif()
-  configure_file("${template_file}" "JuceLibraryCode/AppConfig.h")
+  configure_file("${template_file}" "${JUCER_LIBRARY_CODE_DIR}/AppConfig.h")
   list(APPEND JUCER_PROJECT_SOURCES
-    "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode/AppConfig.h"
+    "${JUCER_LIBRARY_CODE_DIR}/AppConfig.h"
   )
 
   set(JUCER_PROJECT_SOURCES ${JUCER_PROJECT_SOURCES} PARENT_SCOPE)
 
+  _FRUT_profile_end(_FRUT_generate_AppConfig_header)
+
 endfunction()
 
 
 function(_FRUT_generate_JuceHeader_header)
 
+  _FRUT_profile_begin(_FRUT_generate_JuceHeader_header)
+
   list(LENGTH JUCER_PROJECT_RESOURCES resources_count)
   if(resources_count GREATER 0)
-    set(BinaryDataBuilder_version "0.1.0")
-    find_program(BinaryDataBuilder_exe "BinaryDataBuilder-${BinaryDataBuilder_version}"
-      PATHS "${Reprojucer.cmake_DIR}/bin"
-      NO_DEFAULT_PATH
-    )
-    if(NOT BinaryDataBuilder_exe)
-      message(STATUS "Building BinaryDataBuilder")
-      try_compile(BinaryDataBuilder
-        "${Reprojucer.cmake_DIR}/BinaryDataBuilder/_build/${CMAKE_GENERATOR}"
-        "${Reprojucer.cmake_DIR}/BinaryDataBuilder"
-        BinaryDataBuilder install
-        CMAKE_FLAGS
-        "-DJUCE_modules_DIRS=${JUCER_PROJECT_MODULES_FOLDERS}"
-        "-DCMAKE_INSTALL_PREFIX=${Reprojucer.cmake_DIR}/bin"
-      )
-      if(NOT BinaryDataBuilder)
-        message(FATAL_ERROR "Failed to build BinaryDataBuilder")
-      endif()
-      message(STATUS "BinaryDataBuilder has been successfully built")
-      find_program(BinaryDataBuilder_exe "BinaryDataBuilder-${BinaryDataBuilder_version}"
-        PATHS "${Reprojucer.cmake_DIR}/bin"
-        NO_DEFAULT_PATH
-      )
-      if(NOT BinaryDataBuilder_exe)
-        message(FATAL_ERROR
-          "Could not find BinaryDataBuilder-${BinaryDataBuilder_version}"
-        )
-      endif()
+    if(FRUT_TOOLS_AS_TARGET)
+      _FRUT_add_frut_tools_target()
+    else()
+      _FRUT_get_frut_tools_exe(frut_tools_exe)
     endif()
 
     if(NOT JUCER_PROJECT_ID)
@@ -2179,28 +2946,67 @@ function(_FRUT_generate_JuceHeader_header)
     if("${JUCER_BINARYDATA_NAMESPACE}" STREQUAL "")
       set(JUCER_BINARYDATA_NAMESPACE "BinaryData")
     endif()
-    set(BinaryDataBuilder_args
-      "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode/"
+    set(binarydata_args
+      "${JUCER_LIBRARY_CODE_DIR}/"
       "${project_uid}"
       ${size_limit_in_bytes}
       "${JUCER_BINARYDATA_NAMESPACE}"
     )
+    unset(resource_abs_paths)
     foreach(resource_path ${JUCER_PROJECT_RESOURCES})
       get_filename_component(resource_abs_path "${resource_path}" ABSOLUTE)
-      list(APPEND BinaryDataBuilder_args "${resource_abs_path}")
+      list(APPEND resource_abs_paths "${resource_abs_path}")
     endforeach()
-    execute_process(
-      COMMAND "${BinaryDataBuilder_exe}" ${BinaryDataBuilder_args}
-      OUTPUT_VARIABLE binary_data_filenames
-      RESULT_VARIABLE BinaryDataBuilder_return_code
-    )
-    if(NOT BinaryDataBuilder_return_code EQUAL 0)
-      message(FATAL_ERROR "Error when executing BinaryDataBuilder")
+    list(APPEND binarydata_args ${resource_abs_paths})
+
+    if(FRUT_TOOLS_AS_TARGET)
+      # The number of .cpp files depends on the size of the resources when building, but
+      # it is at most the number of resources, so the missing ones are written empty
+      set(binary_data_filenames "BinaryData.h" "BinaryData.cpp")
+      if(resources_count GREATER 1)
+        foreach(index RANGE 2 ${resources_count})
+          list(APPEND binary_data_filenames "BinaryData${index}.cpp")
+        endforeach()
+      endif()
+      unset(binary_data_files)
+      foreach(filename ${binary_data_filenames})
+        list(APPEND binary_data_files
+          "${JUCER_LIBRARY_CODE_DIR}/${filename}"
+        )
+      endforeach()
+      # frut-tools only writes the files whose content changes, so a stamp file records
+      # when they were last generated
+      set(binary_data_stamp
+        "${JUCER_LIBRARY_CODE_DIR}/BinaryData.stamp"
+      )
+      add_custom_command(OUTPUT "${binary_data_stamp}"
+        BYPRODUCTS ${binary_data_files}
+        COMMAND "${CMAKE_COMMAND}"
+        "-Dbinary_data_dir=${JUCER_LIBRARY_CODE_DIR}"
+        "-Dcpp_files_count=${resources_count}"
+        -P "${Reprojucer_templates_DIR}/generate-binary-data.cmake"
+        -- "$<TARGET_FILE:frut-tools>" "binarydata" ${binarydata_args}
+        COMMAND "${CMAKE_COMMAND}" -E touch "${binary_data_stamp}"
+        DEPENDS frut-tools ${resource_abs_paths}
+        VERBATIM
+      )
+      string(REGEX REPLACE "[^A-Za-z0-9_.+-]" "_" target "${JUCER_PROJECT_NAME}")
+      add_custom_target(${target}_BinaryData DEPENDS "${binary_data_stamp}")
+      set(JUCER_BINARY_DATA_TARGET ${target}_BinaryData PARENT_SCOPE)
+    else()
+      execute_process(
+        COMMAND "${frut_tools_exe}" "binarydata" ${binarydata_args}
+        OUTPUT_VARIABLE binary_data_filenames
+        RESULT_VARIABLE binarydata_return_code
+      )
+      if(NOT binarydata_return_code EQUAL 0)
+        message(FATAL_ERROR "Error when executing frut-tools binarydata")
+      endif()
     endif()
 
     foreach(filename ${binary_data_filenames})
       list(APPEND JUCER_PROJECT_SOURCES
-        "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode/${filename}"
+        "${JUCER_LIBRARY_CODE_DIR}/${filename}"
       )
     endforeach()
     if(DEFINED JUCER_INCLUDE_BINARYDATA AND NOT JUCER_INCLUDE_BINARYDATA)
@@ -2221,126 +3027,669 @@ function(_FRUT_generate_JuceHeader_header)
   else()
     set(template_file "${Reprojucer_templates_DIR}/JuceHeader.h")
   endif()
-  configure_file("${template_file}" "JuceLibraryCode/JuceHeader.h")
+  configure_file("${template_file}" "${JUCER_LIBRARY_CODE_DIR}/JuceHeader.h")
   list(APPEND JUCER_PROJECT_SOURCES
-    "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode/JuceHeader.h"
+    "${JUCER_LIBRARY_CODE_DIR}/JuceHeader.h"
   )
 
   set(JUCER_PROJECT_SOURCES ${JUCER_PROJECT_SOURCES} PARENT_SCOPE)
 
+  _FRUT_profile_end(_FRUT_generate_JuceHeader_header)
+
 endfunction()
 
 
-function(_FRUT_generate_icon_file icon_format icon_file_output_dir out_icon_filename)
+function(_FRUT_generate_IsaDispatch_header)
 
-  set(IconBuilder_version "0.1.0")
-  find_program(IconBuilder_exe "IconBuilder-${IconBuilder_version}"
-    PATHS "${Reprojucer.cmake_DIR}/bin"
-    NO_DEFAULT_PATH
-  )
-  if(NOT IconBuilder_exe)
-    message(STATUS "Building IconBuilder")
-    try_compile(IconBuilder
-      "${Reprojucer.cmake_DIR}/IconBuilder/_build/${CMAKE_GENERATOR}"
-      "${Reprojucer.cmake_DIR}/IconBuilder"
-      IconBuilder install
-      CMAKE_FLAGS
-      "-DJUCE_modules_DIRS=${JUCER_PROJECT_MODULES_FOLDERS}"
-      "-DCMAKE_INSTALL_PREFIX=${Reprojucer.cmake_DIR}/bin"
-    )
-    if(NOT IconBuilder)
-      message(FATAL_ERROR "Failed to build IconBuilder")
-    endif()
-    message(STATUS "IconBuilder has been successfully built")
-    find_program(IconBuilder_exe "IconBuilder-${IconBuilder_version}"
-      PATHS "${Reprojucer.cmake_DIR}/bin"
-      NO_DEFAULT_PATH
-    )
-    if(NOT IconBuilder_exe)
-      message(FATAL_ERROR "Could not find IconBuilder-${IconBuilder_version}")
+  _FRUT_profile_begin(_FRUT_generate_IsaDispatch_header)
+
+  set(isa_declare_code "namespace frut_isa_baseline { declaration; }")
+  set(isa_dispatch_code "&frut_isa_baseline::name")
+
+  set(isa_levels "x86-64-v2" "x86-64-v3" "x86-64-v4")
+  foreach(level ${isa_levels})
+    string(REPLACE "-" "_" level_suffix "${level}")
+    string(REGEX REPLACE "^x86-64-v" "" level_number "${level}")
+
+    if("${level}" IN_LIST JUCER_MULTI_ISA_LEVELS)
+      string(APPEND isa_declare_code
+        " \\\n  namespace frut_isa_${level_suffix} { declaration; }"
+      )
+      set(isa_dispatch_code
+        "::frut::isa::getLevel() >= ${level_number} ? &frut_isa_${level_suffix}::name \\\n   : ${isa_dispatch_code}"
+      )
     endif()
-  endif()
+  endforeach()
+
+  configure_file("${Reprojucer_templates_DIR}/IsaDispatch.h"
+    "${JUCER_LIBRARY_CODE_DIR}/IsaDispatch.h" @ONLY
+  )
+  list(APPEND JUCER_PROJECT_SOURCES
+    "${JUCER_LIBRARY_CODE_DIR}/IsaDispatch.h"
+  )
+
+  set(JUCER_PROJECT_SOURCES ${JUCER_PROJECT_SOURCES} PARENT_SCOPE)
 
-  set(IconBuilder_args "${icon_format}" "${icon_file_output_dir}")
+  _FRUT_profile_end(_FRUT_generate_IsaDispatch_header)
+
+endfunction()
+
+
+function(_FRUT_generate_icon_file icon_format icon_file_output_dir out_icon_filename)
+
+  _FRUT_profile_begin(_FRUT_generate_icon_file)
+
+  set(icon_args "${icon_format}" "${icon_file_output_dir}")
   if(DEFINED JUCER_SMALL_ICON)
-    list(APPEND IconBuilder_args "${JUCER_SMALL_ICON}")
+    list(APPEND icon_args "${JUCER_SMALL_ICON}")
   else()
-    list(APPEND IconBuilder_args "<None>")
+    list(APPEND icon_args "<None>")
   endif()
   if(DEFINED JUCER_LARGE_ICON)
-    list(APPEND IconBuilder_args "${JUCER_LARGE_ICON}")
+    list(APPEND icon_args "${JUCER_LARGE_ICON}")
   else()
-    list(APPEND IconBuilder_args "<None>")
+    list(APPEND icon_args "<None>")
   endif()
 
-  execute_process(
-    COMMAND "${IconBuilder_exe}" ${IconBuilder_args}
-    OUTPUT_VARIABLE icon_filename
-    RESULT_VARIABLE IconBuilder_return_code
-  )
-  if(NOT IconBuilder_return_code EQUAL 0)
-    message(FATAL_ERROR "Error when executing IconBuilder")
+  if(FRUT_TOOLS_AS_TARGET)
+    _FRUT_add_frut_tools_target()
+    if(icon_format STREQUAL "icns")
+      set(icon_filename "Icon.icns")
+    else()
+      set(icon_filename "icon.ico")
+    endif()
+    add_custom_command(OUTPUT "${icon_file_output_dir}/${icon_filename}"
+      COMMAND "$<TARGET_FILE:frut-tools>" "icon" ${icon_args}
+      DEPENDS frut-tools ${JUCER_SMALL_ICON} ${JUCER_LARGE_ICON}
+      VERBATIM
+    )
+  else()
+    _FRUT_get_frut_tools_exe(frut_tools_exe)
+    execute_process(
+      COMMAND "${frut_tools_exe}" "icon" ${icon_args}
+      OUTPUT_VARIABLE icon_filename
+      RESULT_VARIABLE icon_return_code
+    )
+    if(NOT icon_return_code EQUAL 0)
+      message(FATAL_ERROR "Error when executing frut-tools icon")
+    endif()
   endif()
 
   if(NOT "${icon_filename}" STREQUAL "")
     set(${out_icon_filename} ${icon_filename} PARENT_SCOPE)
   endif()
 
+  _FRUT_profile_end(_FRUT_generate_icon_file)
+
 endfunction()
 
 
-function(_FRUT_set_output_directory_properties target subfolder)
+function(_FRUT_get_module_metadata_file modules_folder module_name out_file)
 
-  foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
-    unset(output_directory)
-    string(TOUPPER "${config}" upper_config)
+  _FRUT_profile_begin(_FRUT_get_module_metadata_file)
 
-    if(MSVC AND NOT "${subfolder}" STREQUAL ""
-        AND NOT (DEFINED JUCER_VERSION AND JUCER_VERSION VERSION_LESS 5.0.0))
-      if(DEFINED JUCER_BINARY_LOCATION_${config})
-        set(output_directory "${JUCER_BINARY_LOCATION_${config}}/${subfolder}")
-      else()
-        set(output_directory "${CMAKE_CURRENT_BINARY_DIR}/$<CONFIG>/${subfolder}")
-      endif()
-    elseif(DEFINED JUCER_BINARY_LOCATION_${config})
-      set(output_directory "${JUCER_BINARY_LOCATION_${config}}")
+  set(module_dir "${modules_folder}/${module_name}")
+  set(module_header_file "${module_dir}/${module_name}.h")
+
+  # Only IDEs show the browsable files, and globbing the whole module is the slowest part
+  # of jucer_project_module()
+  if(CMAKE_GENERATOR MATCHES "Xcode|Visual Studio" OR CMAKE_EXTRA_GENERATOR)
+    set(scan_browsable_files TRUE)
+  else()
+    set(scan_browsable_files FALSE)
+  endif()
+
+  # The metadata is scanned again when the module header changes (e.g. when updating
+  # JUCE), or when files are added to or removed from the top of the module directory
+  file(SHA1 "${module_header_file}" module_header_hash)
+  file(GLOB module_dir_entries LIST_DIRECTORIES true "${module_dir}/*")
+  string(SHA1 module_dir_entries_hash "${module_dir_entries}")
+  set(metadata_key "3 ${module_header_hash} ${module_dir_entries_hash}")
+  string(APPEND metadata_key " ${scan_browsable_files} ${module_dir}")
+
+  set(metadata_file "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/FRUT/${module_name}.cmake")
+  set(${out_file} "${metadata_file}" PARENT_SCOPE)
+
+  if(EXISTS "${metadata_file}")
+    file(STRINGS "${metadata_file}" metadata_header LIMIT_COUNT 2)
+    list(GET metadata_header 0 first_line)
+    set(current_metadata_key "${metadata_key}")
+    if(scan_browsable_files)
+      # The browsable files are scanned again when files are added to or removed from
+      # one of the subfolders listed on the second line, since it changes its timestamp
+      list(GET metadata_header 1 second_line)
+      string(REGEX REPLACE "^# " "" module_subdirs "${second_line}")
+      string(REPLACE "|" ";" module_subdirs "${module_subdirs}")
+      _FRUT_get_folders_timestamps_hash("${module_subdirs}" module_subdirs_hash)
+      string(APPEND current_metadata_key " ${module_subdirs_hash}")
     endif()
-    if(output_directory)
-      set_target_properties(${target} PROPERTIES
-        ARCHIVE_OUTPUT_DIRECTORY_${upper_config} "${output_directory}"
-        LIBRARY_OUTPUT_DIRECTORY_${upper_config} "${output_directory}"
-        RUNTIME_OUTPUT_DIRECTORY_${upper_config} "${output_directory}"
-      )
+    if(first_line STREQUAL "# ${current_metadata_key}")
+      _FRUT_profile_end(_FRUT_get_module_metadata_file "${module_name}")
+      return()
     endif()
-  endforeach()
+  endif()
 
-endfunction()
+  # Only reached when the metadata is out of date, so that the time spent scanning the
+  # module stands out from the time spent checking the key
+  _FRUT_profile_begin(_FRUT_scan_module)
 
+  file(GLOB module_src_files "${module_dir}/*.cpp" "${module_dir}/*.mm")
 
-function(_FRUT_set_common_target_properties target)
+  file(STRINGS "${module_header_file}" config_flags_lines REGEX "/\\*\\* Config: ")
+  string(REPLACE "/** Config: " "" module_config_flags "${config_flags_lines}")
+
+  unset(module_info_OSXFrameworks)
+  unset(module_info_linuxLibs)
+  unset(module_info_linuxPackages)
+  unset(module_info_minimumCppStandard)
+
+  file(STRINGS "${module_header_file}" all_lines)
+  set(in_module_declaration FALSE)
+  foreach(line ${all_lines})
+    string(STRIP "${line}" stripped_line)
+    if(stripped_line MATCHES "^BEGIN_JUCE_MODULE_DECLARATION")
+      set(in_module_declaration TRUE)
+      continue()
+    elseif(stripped_line MATCHES "^END_JUCE_MODULE_DECLARATION")
+      break()
+    endif()
+
+    if(in_module_declaration)
+      string(FIND "${line}" ":" colon_pos)
+      if(NOT colon_pos EQUAL -1)
+        string(SUBSTRING "${line}" 0 ${colon_pos} key)
+        string(STRIP "${key}" key)
+        math(EXPR colon_pos_plus_one "${colon_pos} + 1")
+        string(SUBSTRING "${line}" ${colon_pos_plus_one} -1 value)
+        string(STRIP "${value}" value)
+        set(module_info_${key} ${value})
+      endif()
+    endif()
+  endforeach()
+
+  unset(module_browsable_files)
+  set(module_subdirs "")
+  if(scan_browsable_files)
+    file(GLOB_RECURSE module_entries LIST_DIRECTORIES true "${module_dir}/*")
+    foreach(entry ${module_entries})
+      if(IS_DIRECTORY "${entry}")
+        list(APPEND module_subdirs "${entry}")
+      else()
+        list(APPEND module_browsable_files "${entry}")
+      endif()
+    endforeach()
+    _FRUT_get_folders_timestamps_hash("${module_subdirs}" module_subdirs_hash)
+    string(APPEND metadata_key " ${module_subdirs_hash}")
+  endif()
+
+  _FRUT_profile_end(_FRUT_scan_module "${module_name}")
+
+  string(REPLACE ";" "|" module_subdirs_line "${module_subdirs}")
+  set(metadata "# ${metadata_key}\n# ${module_subdirs_line}\n")
+  foreach(variable
+      module_src_files
+      module_config_flags
+      module_info_OSXFrameworks
+      module_info_linuxLibs
+      module_info_linuxPackages
+      module_info_minimumCppStandard
+      module_browsable_files
+  )
+    if(DEFINED ${variable})
+      string(APPEND metadata "set(${variable} [==[${${variable}}]==])\n")
+    else()
+      string(APPEND metadata "unset(${variable})\n")
+    endif()
+  endforeach()
+  file(WRITE "${metadata_file}" "${metadata}")
+
+  _FRUT_profile_end(_FRUT_get_module_metadata_file "${module_name}")
+
+endfunction()
+
+
+function(_FRUT_get_folders_timestamps_hash folders out_hash)
+
+  # A timestamp in seconds misses a change made in the same second as the previous
+  # configure, so the entries of the folders are hashed instead when %f (microseconds) is
+  # not supported
+  set(timestamps "")
+  foreach(folder IN LISTS folders)
+    if(CMAKE_VERSION VERSION_LESS 3.23)
+      file(GLOB folder_entries LIST_DIRECTORIES true "${folder}/*")
+      string(APPEND timestamps "${folder_entries};")
+    else()
+      file(TIMESTAMP "${folder}" timestamp "%s%f")
+      string(APPEND timestamps "${timestamp} ")
+    endif()
+  endforeach()
+  string(SHA1 hash "${timestamps}")
+  set(${out_hash} "${hash}" PARENT_SCOPE)
+
+endfunction()
+
+
+function(_FRUT_split_module_source_file
+  module_name modules_folder src_file proxy_prefix out_wrappers
+)
+
+  set(FRUT_JUCE_MODULE_SPLIT_PARTS "4" CACHE STRING
+    "Number of translation units used to compile a split JUCE module"
+  )
+  if(NOT FRUT_JUCE_MODULE_SPLIT_PARTS MATCHES "^[1-9][0-9]*$")
+    message(FATAL_ERROR "Unsupported value for FRUT_JUCE_MODULE_SPLIT_PARTS: "
+      "\"${FRUT_JUCE_MODULE_SPLIT_PARTS}\"\nSupported values: positive integers"
+    )
+  endif()
+
+  set(module_dir "${modules_folder}/${module_name}")
+  # The .mm variant of a module only includes the .cpp one to compile it as Objective-C++
+  file(READ "${module_dir}/${module_name}.cpp" module_source)
+
+  # Each part is a copy of the main file of the module, so the main file must not contain
+  # anything but comments, preprocessor directives and namespace blocks, which can be
+  # repeated in each translation unit
+  string(REGEX REPLACE "/\\*([^*]|\\*+[^*/])*\\*+/" "" module_code "${module_source}")
+  string(REGEX REPLACE "//[^\n]*" "" module_code "${module_code}")
+  string(REGEX REPLACE "(^|\n)[ \t]*#([^\n]*\\\\\n)*[^\n]*" "\n"
+    module_code "${module_code}"
+  )
+  string(REGEX REPLACE "namespace[ \t\r\n]+[A-Za-z_][A-Za-z0-9_:]*|[{}]" ""
+    module_code "${module_code}"
+  )
+  if(NOT module_code MATCHES "^[ \t\r\n]*$")
+    message(STATUS "${module_name} is not split, because ${module_name}.cpp contains "
+      "code other than includes"
+    )
+    set(${out_wrappers} "" PARENT_SCOPE)
+    return()
+  endif()
+
+  string(REGEX MATCHALL "#[ \t]*include[ \t]+\"[^\"]+\""
+    include_directives "${module_source}"
+  )
+  set(included_src_files "")
+  foreach(directive ${include_directives})
+    string(REGEX REPLACE "^#[ \t]*include[ \t]+\"([^\"]+)\"$" "\\1"
+      included_file "${directive}"
+    )
+    # The wrappers live in JuceLibraryCode/, so includes relative to the module folder
+    # are rewritten to go through the modules folders in the header search paths
+    if(EXISTS "${module_dir}/${included_file}")
+      string(REPLACE "${directive}" "#include <${module_name}/${included_file}>"
+        module_source "${module_source}"
+      )
+      if(included_file MATCHES "\\.(c|cpp|mm)$"
+          AND NOT "${included_file}" IN_LIST included_src_files)
+        list(APPEND included_src_files "${included_file}")
+      endif()
+    endif()
+  endforeach()
+
+  list(LENGTH included_src_files included_src_files_count)
+  set(parts_count ${FRUT_JUCE_MODULE_SPLIT_PARTS})
+  if(parts_count GREATER included_src_files_count)
+    set(parts_count ${included_src_files_count})
+  endif()
+  if(parts_count LESS 2)
+    set(${out_wrappers} "" PARENT_SCOPE)
+    return()
+  endif()
+
+  get_filename_component(src_file_extension "${src_file}" EXT)
+  set(wrappers "")
+  foreach(part RANGE 1 ${parts_count})
+    set(split_module_source "${module_source}")
+    set(index 0)
+    foreach(included_file ${included_src_files})
+      # Contiguous chunks keep the files that depend on each other together
+      math(EXPR included_file_part
+        "${index} * ${parts_count} / ${included_src_files_count} + 1"
+      )
+      if(NOT included_file_part EQUAL part)
+        string(REPLACE "#include <${module_name}/${included_file}>"
+          "// #include <${module_name}/${included_file}> (part ${included_file_part})"
+          split_module_source "${split_module_source}"
+        )
+      endif()
+      math(EXPR index "${index} + 1")
+    endforeach()
+
+    # The source of the module is written as is (configure_file() would replace its
+    # @VAR@ sequences), and only when it changed, so that the part is not rebuilt after
+    # each configure
+    set(wrapper_file "${proxy_prefix}${module_name}_${part}${src_file_extension}")
+    set(wrapper_path "${JUCER_LIBRARY_CODE_DIR}/${wrapper_file}")
+    set(wrapper_content "#include \"AppConfig.h\"\n\n${split_module_source}")
+    set(previous_wrapper_content "")
+    if(EXISTS "${wrapper_path}")
+      file(READ "${wrapper_path}" previous_wrapper_content)
+    endif()
+    if(NOT previous_wrapper_content STREQUAL wrapper_content)
+      file(WRITE "${wrapper_path}" "${wrapper_content}")
+    endif()
+    list(APPEND wrappers "${wrapper_path}")
+  endforeach()
+
+  set(${out_wrappers} ${wrappers} PARENT_SCOPE)
+
+endfunction()
+
+
+function(_FRUT_set_compiler_flag_scheme_properties)
 
+  get_property(paths GLOBAL PROPERTY FRUT_PROJECT_FILES_WITH_SCHEME)
+  set_property(GLOBAL PROPERTY FRUT_PROJECT_FILES_WITH_SCHEME "")
+  if(NOT paths)
+    return()
+  endif()
+
+  set(schemes_defined FALSE)
+  if(DEFINED JUCER_COMPILER_FLAG_SCHEMES)
+    set(schemes_defined TRUE)
+  endif()
   foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
-    string(TOUPPER "${config}" upper_config)
+    if(DEFINED JUCER_COMPILER_FLAG_SCHEMES_${config})
+      set(schemes_defined TRUE)
+    endif()
+  endforeach()
+  if(NOT schemes_defined)
+    return()
+  endif()
 
-    if(JUCER_BINARY_NAME_${config})
-      set(output_name "${JUCER_BINARY_NAME_${config}}")
+  list(REMOVE_DUPLICATES paths)
+
+  foreach(path ${paths})
+    get_source_file_property(scheme "${path}" FRUT_COMPILER_FLAG_SCHEME)
+    if(NOT scheme)
+      continue()
+    endif()
+
+    _FRUT_get_compiler_flag_scheme_flags(
+      "${JUCER_COMPILER_FLAG_SCHEMES}" "${scheme}" exporter_flags
+    )
+    set(all_confs_flags "${exporter_flags}")
+    unset(config_flags_genexes)
+    unset(config_flags_overrides)
+    foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+      _FRUT_get_compiler_flag_scheme_flags(
+        "${JUCER_COMPILER_FLAG_SCHEMES_${config}}" "${scheme}" config_flags
+      )
+      if(DEFINED config_flags)
+        set(config_flags_overrides TRUE)
+      else()
+        set(config_flags "${exporter_flags}")
+      endif()
+      string(APPEND config_flags_genexes " $<$<CONFIG:${config}>:${config_flags}>")
+    endforeach()
+
+    if(config_flags_overrides)
+      if(CMAKE_VERSION VERSION_LESS 3.8 OR CMAKE_GENERATOR STREQUAL "Xcode")
+        message(FATAL_ERROR "Overriding the flags of the compiler flag scheme "
+          "\"${scheme}\" per configuration requires CMake 3.8 or later, and is not "
+          "supported by the Xcode generator."
+        )
+      endif()
+      set(all_confs_flags "${config_flags_genexes}")
+    endif()
+
+    if(NOT all_confs_flags STREQUAL "")
+      set_property(SOURCE "${path}" APPEND_STRING PROPERTY COMPILE_FLAGS
+        " ${all_confs_flags}"
+      )
+    endif()
+  endforeach()
+
+endfunction()
+
+
+function(_FRUT_use_heavy_compile_job_pool target sources_var)
+
+  if(NOT CMAKE_GENERATOR MATCHES "Ninja")
+    return()
+  endif()
+
+  set(FRUT_HEAVY_COMPILE_MEMORY_PER_JOB "1536" CACHE STRING
+    "Memory (in MiB) that one JUCE module or BinaryData translation unit can need"
+  )
+  set(FRUT_HEAVY_COMPILE_JOBS "" CACHE STRING
+    "Maximum number of JUCE module and BinaryData translation units compiled concurrently"
+  )
+
+  if("${FRUT_HEAVY_COMPILE_JOBS}" STREQUAL "")
+    cmake_host_system_information(RESULT total_memory QUERY TOTAL_PHYSICAL_MEMORY)
+    math(EXPR heavy_compile_jobs
+      "${total_memory} / ${FRUT_HEAVY_COMPILE_MEMORY_PER_JOB}"
+    )
+    if(heavy_compile_jobs LESS 1)
+      set(heavy_compile_jobs 1)
+    endif()
+  elseif(FRUT_HEAVY_COMPILE_JOBS MATCHES "^[0-9]+$")
+    set(heavy_compile_jobs ${FRUT_HEAVY_COMPILE_JOBS})
+  else()
+    message(FATAL_ERROR
+      "Unsupported value for FRUT_HEAVY_COMPILE_JOBS: \"${FRUT_HEAVY_COMPILE_JOBS}\""
+    )
+  endif()
+
+  if(heavy_compile_jobs EQUAL 0)
+    return()
+  endif()
+
+  # Module wrappers and BinaryData files are the only translation units generated in
+  # JuceLibraryCode/
+  unset(heavy_sources)
+  foreach(src_file ${${sources_var}})
+    get_filename_component(src_file_dir "${src_file}" DIRECTORY)
+    get_filename_component(src_file_extension "${src_file}" EXT)
+    get_source_file_property(is_header_file_only "${src_file}" HEADER_FILE_ONLY)
+    if(src_file_dir STREQUAL "${JUCER_LIBRARY_CODE_DIR}"
+        AND src_file_extension MATCHES "^\\.(c|cpp|m|mm)$"
+        AND NOT is_header_file_only)
+      list(APPEND heavy_sources "${src_file}")
+    endif()
+  endforeach()
+
+  if(NOT heavy_sources)
+    return()
+  endif()
+
+  get_property(job_pools GLOBAL PROPERTY JOB_POOLS)
+  if(NOT job_pools MATCHES "(^|;)frut_heavy_compile=")
+    set_property(GLOBAL APPEND PROPERTY JOB_POOLS
+      "frut_heavy_compile=${heavy_compile_jobs}"
+    )
+  endif()
+
+  # Ninja job pools can only be set per target, so the heavy translation units are
+  # compiled as part of an object library that uses the same settings as ${target}
+  set(heavy_target ${target}_JuceLibraryCode)
+  add_library(${heavy_target} OBJECT ${heavy_sources})
+  _FRUT_set_object_library_properties(${heavy_target} ${target})
+  set_target_properties(${heavy_target} PROPERTIES
+    JOB_POOL_COMPILE "frut_heavy_compile"
+  )
+
+  set(sources ${${sources_var}})
+  list(REMOVE_ITEM sources ${heavy_sources})
+  list(APPEND sources $<TARGET_OBJECTS:${heavy_target}>)
+  set(${sources_var} ${sources} PARENT_SCOPE)
+
+endfunction()
+
+
+function(_FRUT_add_multi_isa_variants target sources_var)
+
+  if(NOT DEFINED JUCER_MULTI_ISA_SOURCES
+      OR NOT CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$")
+    return()
+  endif()
+
+  set(isa_sources "")
+  foreach(src_file ${${sources_var}})
+    if("${src_file}" IN_LIST JUCER_MULTI_ISA_SOURCES)
+      list(APPEND isa_sources "${src_file}")
+    endif()
+  endforeach()
+  if(NOT isa_sources)
+    return()
+  endif()
+
+  if((CMAKE_CXX_COMPILER_ID STREQUAL "GNU" AND CMAKE_CXX_COMPILER_VERSION VERSION_LESS 11)
+      OR (CMAKE_CXX_COMPILER_ID STREQUAL "Clang"
+        AND CMAKE_CXX_COMPILER_VERSION VERSION_LESS 12))
+    message(FATAL_ERROR "MULTI_ISA_SOURCES requires GCC 11 or later, or Clang 12 or later"
+      " (for -march=x86-64-v2, -march=x86-64-v3 and -march=x86-64-v4)"
+    )
+  endif()
+
+  set(sources ${${sources_var}})
+  list(REMOVE_ITEM sources ${isa_sources})
+
+  # Each variant is compiled in its own object library since the same source files get
+  # different -march flags and FRUT_ISA_NAMESPACE values
+  foreach(level "x86-64" ${JUCER_MULTI_ISA_LEVELS})
+    string(REPLACE "-" "_" level_suffix "${level}")
+    set(variant_target ${target}_${level_suffix})
+    add_library(${variant_target} OBJECT ${isa_sources})
+    _FRUT_set_object_library_properties(${variant_target} ${target})
+    if(level STREQUAL "x86-64")
+      target_compile_definitions(${variant_target} PRIVATE
+        "FRUT_ISA_NAMESPACE=frut_isa_baseline"
+      )
     else()
-      set(output_name "${JUCER_PROJECT_NAME}")
+      target_compile_definitions(${variant_target} PRIVATE
+        "FRUT_ISA_NAMESPACE=frut_isa_${level_suffix}"
+      )
     endif()
-    set_target_properties(${target} PROPERTIES
-      OUTPUT_NAME_${upper_config} "${output_name}"
+    # Comes after the architecture flag of ${target}, so it takes precedence
+    target_compile_options(${variant_target} PRIVATE "-march=${level}")
+    list(APPEND sources $<TARGET_OBJECTS:${variant_target}>)
+    if(NOT level STREQUAL "x86-64")
+      set_property(GLOBAL APPEND PROPERTY FRUT_MULTI_ISA_VARIANTS_${target}
+        ${variant_target}
+      )
+    endif()
+  endforeach()
+
+  set(${sources_var} ${sources} PARENT_SCOPE)
+
+endfunction()
+
+
+function(_FRUT_add_multi_isa_check target)
+
+  get_property(variant_targets GLOBAL PROPERTY FRUT_MULTI_ISA_VARIANTS_${target})
+  if(NOT variant_targets)
+    return()
+  endif()
+
+  if(NOT CMAKE_NM)
+    message(WARNING "nm was not found, so the objects of the MULTI_ISA_SOURCES are not"
+      " checked for inline or template functions outside of FRUT_ISA_NAMESPACE"
+    )
+    return()
+  endif()
+
+  string(LENGTH "${target}_" prefix_length)
+  foreach(variant_target ${variant_targets})
+    string(SUBSTRING "${variant_target}" ${prefix_length} -1 level_suffix)
+    add_custom_command(TARGET ${target} PRE_LINK
+      COMMAND
+      "${CMAKE_COMMAND}"
+      "-Dnm=${CMAKE_NM}"
+      "-Disa_namespace=frut_isa_${level_suffix}"
+      "-Dobjects=$<JOIN:$<TARGET_OBJECTS:${variant_target}>,|>"
+      "-P" "${Reprojucer_templates_DIR}/check-multi-isa-objects.cmake"
+      VERBATIM
     )
   endforeach()
 
-  target_include_directories(${target} PRIVATE
-    "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode"
+endfunction()
+
+
+function(_FRUT_set_object_library_properties object_target target)
+
+  target_include_directories(${object_target} PRIVATE
+    $<TARGET_PROPERTY:${target},INCLUDE_DIRECTORIES>
+  )
+  target_compile_definitions(${object_target} PRIVATE
+    $<TARGET_PROPERTY:${target},COMPILE_DEFINITIONS>
+  )
+  target_compile_options(${object_target} PRIVATE
+    $<TARGET_PROPERTY:${target},COMPILE_OPTIONS>
+  )
+  _FRUT_set_cxx_language_standard_properties(${object_target})
+  if(JUCER_PROJECT_TYPE STREQUAL "Dynamic Library"
+      OR JUCER_PROJECT_TYPE STREQUAL "Audio Plug-in")
+    set_target_properties(${object_target} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+  endif()
+  _FRUT_set_compiler_launcher_properties(${object_target})
+  if(DEFINED JUCER_BINARY_DATA_TARGET)
+    add_dependencies(${object_target} ${JUCER_BINARY_DATA_TARGET})
+  endif()
+
+endfunction()
+
+
+function(_FRUT_get_built_configurations out_configs)
+
+  # Multi-configuration generators (Xcode, Visual Studio, Ninja Multi-Config) build all
+  # the configurations of the project from the same build tree
+  if(DEFINED CMAKE_CONFIGURATION_TYPES)
+    set(${out_configs} ${JUCER_PROJECT_CONFIGURATIONS} PARENT_SCOPE)
+  else()
+    set(${out_configs} ${CMAKE_BUILD_TYPE} PARENT_SCOPE)
+  endif()
+
+endfunction()
+
+
+function(_FRUT_set_output_directory_properties target subfolder)
+
+  foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+    unset(output_directory)
+    string(TOUPPER "${config}" upper_config)
+
+    if(MSVC AND NOT "${subfolder}" STREQUAL ""
+        AND NOT (DEFINED JUCER_VERSION AND JUCER_VERSION VERSION_LESS 5.0.0))
+      if(DEFINED JUCER_BINARY_LOCATION_${config})
+        set(output_directory "${JUCER_BINARY_LOCATION_${config}}/${subfolder}")
+      else()
+        set(output_directory "${CMAKE_CURRENT_BINARY_DIR}/$<CONFIG>/${subfolder}")
+      endif()
+    elseif(DEFINED JUCER_BINARY_LOCATION_${config})
+      set(output_directory "${JUCER_BINARY_LOCATION_${config}}")
+    endif()
+    if(output_directory)
+      set_target_properties(${target} PROPERTIES
+        ARCHIVE_OUTPUT_DIRECTORY_${upper_config} "${output_directory}"
+        LIBRARY_OUTPUT_DIRECTORY_${upper_config} "${output_directory}"
+        RUNTIME_OUTPUT_DIRECTORY_${upper_config} "${output_directory}"
+      )
+    endif()
+  endforeach()
+
+endfunction()
+
+
+function(_FRUT_add_project_settings_target settings_target)
+
+  _FRUT_profile_begin(_FRUT_add_project_settings_target)
+
+  add_library(${settings_target} INTERFACE)
+
+  target_include_directories(${settings_target} INTERFACE
+    "${JUCER_LIBRARY_CODE_DIR}"
     ${JUCER_PROJECT_MODULES_FOLDERS}
   )
   foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
     set(search_paths ${JUCER_HEADER_SEARCH_PATHS_${config}})
-    target_include_directories(${target} PRIVATE $<$<CONFIG:${config}>:${search_paths}>)
+    target_include_directories(${settings_target} INTERFACE
+      $<$<CONFIG:${config}>:${search_paths}>
+    )
   endforeach()
-  target_include_directories(${target} PRIVATE ${JUCER_HEADER_SEARCH_PATHS})
+  target_include_directories(${settings_target} INTERFACE ${JUCER_HEADER_SEARCH_PATHS})
 
   if(JUCER_BUILD_VST OR JUCER_FLAG_JUCE_PLUGINHOST_VST)
     if(DEFINED JUCER_VST_SDK_FOLDER)
@@ -2353,7 +3702,7 @@ function(_FRUT_set_common_target_properties target)
           "to contain the VST SDK"
         )
       endif()
-      target_include_directories(${target} PRIVATE "${JUCER_VST_SDK_FOLDER}")
+      target_include_directories(${settings_target} INTERFACE "${JUCER_VST_SDK_FOLDER}")
     elseif(DEFINED JUCER_VERSION AND JUCER_VERSION VERSION_LESS 4.2.4)
       message(WARNING "JUCER_VST_SDK_FOLDER is not defined. You should give "
         "VST_SDK_FOLDER when calling jucer_export_target()."
@@ -2367,75 +3716,398 @@ function(_FRUT_set_common_target_properties target)
         message(WARNING
           "JUCER_VST3_SDK_FOLDER: no such directory \"${JUCER_VST3_SDK_FOLDER}\""
         )
-      elseif(NOT EXISTS "${JUCER_VST3_SDK_FOLDER}/base/source/baseiids.cpp")
-        message(WARNING "JUCER_VST3_SDK_FOLDER: \"${JUCER_VST3_SDK_FOLDER}\" doesn't "
-          "seem to contain the VST3 SDK"
+      elseif(NOT EXISTS "${JUCER_VST3_SDK_FOLDER}/base/source/baseiids.cpp")
+        message(WARNING "JUCER_VST3_SDK_FOLDER: \"${JUCER_VST3_SDK_FOLDER}\" doesn't "
+          "seem to contain the VST3 SDK"
+        )
+      endif()
+      target_include_directories(${settings_target} INTERFACE "${JUCER_VST3_SDK_FOLDER}")
+    elseif(APPLE OR MSVC)
+      message(WARNING "JUCER_VST3_SDK_FOLDER is not defined. You should give "
+        "VST3_SDK_FOLDER when calling jucer_export_target()."
+      )
+    endif()
+  endif()
+
+  foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+    if(JUCER_OPTIMISATION_FLAG_${config})
+      set(optimisation_flag ${JUCER_OPTIMISATION_FLAG_${config}})
+      target_compile_options(${settings_target} INTERFACE
+        $<$<CONFIG:${config}>:${optimisation_flag}>
+      )
+    endif()
+  endforeach()
+
+  target_compile_definitions(${settings_target} INTERFACE
+    ${JUCER_PREPROCESSOR_DEFINITIONS}
+    ${JUCER_EXTRA_PREPROCESSOR_DEFINITIONS}
+  )
+  foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+    set(definitions ${JUCER_PREPROCESSOR_DEFINITIONS_${config}})
+    target_compile_definitions(${settings_target} INTERFACE
+      $<$<CONFIG:${config}>:${definitions}>
+    )
+  endforeach()
+
+  target_link_libraries(${settings_target} INTERFACE ${JUCER_EXTERNAL_LIBRARIES_TO_LINK})
+
+  if(APPLE)
+    foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+      if(${JUCER_CONFIGURATION_IS_DEBUG_${config}})
+        target_compile_definitions(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:_DEBUG=1>
+          $<$<CONFIG:${config}>:DEBUG=1>
+        )
+      else()
+        target_compile_definitions(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:_NDEBUG=1>
+          $<$<CONFIG:${config}>:NDEBUG=1>
+        )
+      endif()
+
+      if(DEFINED JUCER_CXX_LIBRARY_${config})
+        set(cxx_library ${JUCER_CXX_LIBRARY_${config}})
+        target_compile_options(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:-stdlib=${cxx_library}>
+        )
+      endif()
+
+      if(JUCER_RELAX_IEEE_COMPLIANCE_${config})
+        target_compile_options(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:-ffast-math>
+        )
+      endif()
+
+      if(JUCER_LINK_TIME_OPTIMISATION_${config})
+        target_compile_options(${settings_target} INTERFACE $<$<CONFIG:${config}>:-flto>)
+      endif()
+
+      foreach(path ${JUCER_EXTRA_LIBRARY_SEARCH_PATHS_${config}})
+        target_link_libraries(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:-L${path}>
+        )
+      endforeach()
+    endforeach()
+
+  elseif(MSVC)
+    target_compile_definitions(${settings_target} INTERFACE "_CRT_SECURE_NO_WARNINGS")
+    target_compile_options(${settings_target} INTERFACE "/MP")
+
+    foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+      if(${JUCER_CONFIGURATION_IS_DEBUG_${config}})
+        target_compile_definitions(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:DEBUG>
+          $<$<CONFIG:${config}>:_DEBUG>
+        )
+      else()
+        target_compile_definitions(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:NDEBUG>
+        )
+
+        if(NOT JUCER_ALWAYS_DISABLE_WPO_${config})
+          target_compile_options(${settings_target} INTERFACE
+            $<$<CONFIG:${config}>:/GL>
+          )
+        endif()
+      endif()
+
+      if(NOT DEFINED JUCER_CHARACTER_SET_${config}
+          OR JUCER_CHARACTER_SET_${config} STREQUAL "Default")
+        target_compile_definitions(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:_SBCS>
+        )
+      elseif(JUCER_CHARACTER_SET_${config} STREQUAL "MultiByte")
+        # Nothing to do, this is CMake's default
+      elseif(JUCER_CHARACTER_SET_${config} STREQUAL "Unicode")
+        target_compile_definitions(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:_UNICODE>
+          $<$<CONFIG:${config}>:UNICODE>
         )
       endif()
-      target_include_directories(${target} PRIVATE "${JUCER_VST3_SDK_FOLDER}")
-    elseif(APPLE OR MSVC)
-      message(WARNING "JUCER_VST3_SDK_FOLDER is not defined. You should give "
-        "VST3_SDK_FOLDER when calling jucer_export_target()."
+
+      if(DEFINED JUCER_RUNTIME_LIBRARY_FLAG_${config})
+        set(runtime_library_flag ${JUCER_RUNTIME_LIBRARY_FLAG_${config}})
+      elseif(JUCER_BUILD_VST OR JUCER_BUILD_VST3)
+        if(JUCER_CONFIGURATION_IS_DEBUG_${config})
+          set(runtime_library_flag "/MDd")
+        else()
+          set(runtime_library_flag "/MD")
+        endif()
+      else()
+        if(JUCER_CONFIGURATION_IS_DEBUG_${config})
+          set(runtime_library_flag "/MTd")
+        else()
+          set(runtime_library_flag "/MT")
+        endif()
+      endif()
+      target_compile_options(${settings_target} INTERFACE
+        $<$<CONFIG:${config}>:${runtime_library_flag}>
       )
-    endif()
-  endif()
 
-  foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
-    if(JUCER_OPTIMISATION_FLAG_${config})
-      set(optimisation_flag ${JUCER_OPTIMISATION_FLAG_${config}})
-      target_compile_options(${target} PRIVATE
-        $<$<CONFIG:${config}>:${optimisation_flag}>
+      if(DEFINED JUCER_WARNING_LEVEL_FLAG_${config})
+        set(warning_level_flag ${JUCER_WARNING_LEVEL_FLAG_${config}})
+      else()
+        set(warning_level_flag "/W4")
+      endif()
+      target_compile_options(${settings_target} INTERFACE
+        $<$<CONFIG:${config}>:${warning_level_flag}>
       )
-    endif()
-  endforeach()
 
-  target_compile_definitions(${target} PRIVATE
-    ${JUCER_PREPROCESSOR_DEFINITIONS}
-    ${JUCER_EXTRA_PREPROCESSOR_DEFINITIONS}
-  )
-  foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
-    set(definitions ${JUCER_PREPROCESSOR_DEFINITIONS_${config}})
-    target_compile_definitions(${target} PRIVATE $<$<CONFIG:${config}>:${definitions}>)
-  endforeach()
+      if(JUCER_TREAT_WARNINGS_AS_ERRORS_${config})
+        target_compile_options(${settings_target} INTERFACE $<$<CONFIG:${config}>:/WX>)
+      endif()
 
-  target_link_libraries(${target} PRIVATE ${JUCER_EXTERNAL_LIBRARIES_TO_LINK})
+      if(JUCER_RELAX_IEEE_COMPLIANCE_${config})
+        target_compile_options(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:/fp:fast>
+        )
+      endif()
 
-  _FRUT_set_cxx_language_standard_properties(${target})
+      foreach(path ${JUCER_EXTRA_LIBRARY_SEARCH_PATHS_${config}})
+        target_link_libraries(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:-LIBPATH:${path}>
+        )
+      endforeach()
+    endforeach()
 
-  if(APPLE)
+  elseif(CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux")
     foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
       if(${JUCER_CONFIGURATION_IS_DEBUG_${config}})
-        target_compile_definitions(${target} PRIVATE
-          $<$<CONFIG:${config}>:_DEBUG=1>
+        target_compile_definitions(${settings_target} INTERFACE
           $<$<CONFIG:${config}>:DEBUG=1>
+          $<$<CONFIG:${config}>:_DEBUG=1>
         )
       else()
-        target_compile_definitions(${target} PRIVATE
-          $<$<CONFIG:${config}>:_NDEBUG=1>
+        target_compile_definitions(${settings_target} INTERFACE
           $<$<CONFIG:${config}>:NDEBUG=1>
         )
       endif()
 
-      if(DEFINED JUCER_CXX_LIBRARY_${config})
-        set(cxx_library ${JUCER_CXX_LIBRARY_${config}})
-        target_compile_options(${target} PRIVATE
-          $<$<CONFIG:${config}>:-stdlib=${cxx_library}>
+      if(DEFINED JUCER_ARCHITECTURE_FLAG_${config})
+        set(architecture_flag ${JUCER_ARCHITECTURE_FLAG_${config}})
+      elseif(DEFINED JUCER_MULTI_ISA_SOURCES
+          AND CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$")
+        # The binary must run on any x86-64 CPU, MULTI_ISA_SOURCES provide the speed
+        set(architecture_flag "-march=x86-64")
+      else()
+        set(architecture_flag "-march=native")
+      endif()
+      target_compile_options(${settings_target} INTERFACE
+        $<$<CONFIG:${config}>:${architecture_flag}>
+      )
+
+      set(linker "default")
+      if(DEFINED JUCER_LINKER_${config})
+        set(linker ${JUCER_LINKER_${config}})
+      endif()
+      if(linker STREQUAL "mold" AND CMAKE_CXX_COMPILER_ID STREQUAL "GNU"
+          AND CMAKE_CXX_COMPILER_VERSION VERSION_LESS 12.1)
+        # -fuse-ld=mold is only supported since GCC 12.1
+        get_filename_component(mold_dir "${mold_linker_exe}" DIRECTORY)
+        target_link_libraries(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:-B${mold_dir}/../libexec/mold>
+        )
+      elseif(NOT linker STREQUAL "default")
+        target_link_libraries(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:-fuse-ld=${linker}>
         )
       endif()
 
-      if(JUCER_RELAX_IEEE_COMPLIANCE_${config})
-        target_compile_options(${target} PRIVATE $<$<CONFIG:${config}>:-ffast-math>)
+      if(JUCER_SPLIT_DWARF_${config})
+        target_compile_options(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:-gsplit-dwarf>
+        )
+        # GNU ld (the default linker) cannot build the .gdb_index section
+        if(NOT linker STREQUAL "default")
+          target_link_libraries(${settings_target} INTERFACE
+            $<$<CONFIG:${config}>:-Wl,--gdb-index>
+          )
+        endif()
+      endif()
+
+      if(JUCER_COMPRESS_DEBUG_SECTIONS_${config})
+        target_compile_options(${settings_target} INTERFACE $<$<CONFIG:${config}>:-gz>)
+        target_link_libraries(${settings_target} INTERFACE $<$<CONFIG:${config}>:-gz>)
+      endif()
+
+      if(JUCER_SEPARATE_DEBUG_SYMBOLS_${config})
+        target_link_libraries(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:-Wl,--build-id>
+        )
       endif()
 
       if(JUCER_LINK_TIME_OPTIMISATION_${config})
-        target_compile_options(${target} PRIVATE $<$<CONFIG:${config}>:-flto>)
+        if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+          set(lto_flag "-flto=thin")
+          set(thinlto_cache_dir "${CMAKE_CURRENT_BINARY_DIR}/ThinLTOCache")
+          if(linker STREQUAL "lld")
+            set(thinlto_cache_flag "-Wl,--thinlto-cache-dir=${thinlto_cache_dir}")
+          else()
+            set(thinlto_cache_flag "-Wl,-plugin-opt,cache-dir=${thinlto_cache_dir}")
+          endif()
+          set(lto_link_flags "${lto_flag}" "${thinlto_cache_flag}")
+        else()
+          if(CMAKE_CXX_COMPILER_VERSION VERSION_LESS 10)
+            set(lto_flag "-flto")
+          else()
+            set(lto_flag "-flto=auto")
+          endif()
+          set(lto_link_flags "${lto_flag}")
+        endif()
+        target_compile_options(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:${lto_flag}>
+        )
+        foreach(flag ${lto_link_flags})
+          target_link_libraries(${settings_target} INTERFACE
+            $<$<CONFIG:${config}>:${flag}>
+          )
+        endforeach()
+      endif()
+
+      if(DEFINED JUCER_PROFILING_${config})
+        set(profiling_flags "-g" "-fno-omit-frame-pointer")
+        if(JUCER_PROFILING_${config} STREQUAL "perf")
+          if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i.86|aarch64|arm64)$")
+            # Keep the frame pointer in leaf functions too, for complete call stacks
+            list(APPEND profiling_flags "-mno-omit-leaf-frame-pointer")
+          endif()
+        elseif(JUCER_PROFILING_${config} STREQUAL "instrument-functions")
+          list(APPEND profiling_flags "-finstrument-functions")
+        elseif(JUCER_PROFILING_${config} STREQUAL "gprof")
+          list(APPEND profiling_flags "-pg")
+          target_link_libraries(${settings_target} INTERFACE $<$<CONFIG:${config}>:-pg>)
+          # gprof cannot map the addresses recorded in gmon.out by a position
+          # independent executable to its symbols
+          set(is_executable $<STREQUAL:$<TARGET_PROPERTY:TYPE>,EXECUTABLE>)
+          target_link_libraries(${settings_target} INTERFACE
+            $<$<AND:$<CONFIG:${config}>,${is_executable}>:-no-pie>
+          )
+        endif()
+        foreach(flag ${profiling_flags})
+          target_compile_options(${settings_target} INTERFACE
+            $<$<CONFIG:${config}>:${flag}>
+          )
+        endforeach()
+      endif()
+
+      if(JUCER_PROFILE_GUIDED_OPTIMISATION_${config})
+        _FRUT_get_profile_guided_optimisation_flags("${config}" pgo_flags)
+        foreach(flag ${pgo_flags})
+          target_compile_options(${settings_target} INTERFACE
+            $<$<CONFIG:${config}>:${flag}>
+          )
+          target_link_libraries(${settings_target} INTERFACE
+            $<$<CONFIG:${config}>:${flag}>
+          )
+        endforeach()
       endif()
 
       foreach(path ${JUCER_EXTRA_LIBRARY_SEARCH_PATHS_${config}})
-        target_link_libraries(${target} PRIVATE $<$<CONFIG:${config}>:-L${path}>)
+        target_link_libraries(${settings_target} INTERFACE
+          $<$<CONFIG:${config}>:-L${path}>
+        )
       endforeach()
     endforeach()
 
+    _FRUT_get_linux_package_targets(linux_package_targets)
+    if(linux_package_targets)
+      target_link_libraries(${settings_target} INTERFACE ${linux_package_targets})
+    else()
+      if("juce_graphics" IN_LIST JUCER_PROJECT_MODULES)
+        target_include_directories(${settings_target} INTERFACE "/usr/include/freetype2")
+      endif()
+      if(JUCER_FLAG_JUCE_USE_CURL)
+        target_link_libraries(${settings_target} INTERFACE "-lcurl")
+      endif()
+    endif()
+
+    set(linux_libs ${JUCER_PROJECT_LINUX_LIBS})
+    if(linux_libs)
+      list(SORT linux_libs)
+      list(REMOVE_DUPLICATES linux_libs)
+      foreach(item ${linux_libs})
+        if(item STREQUAL "pthread")
+          target_compile_options(${settings_target} INTERFACE "-pthread")
+        endif()
+        target_link_libraries(${settings_target} INTERFACE "-l${item}")
+      endforeach()
+    endif()
+  endif()
+
+  if(DEFINED JUCER_COMPILER_CACHE)
+    # Make __FILE__ and the debug info independent of where the project is checked out
+    # and built, so that the objects can be shared between build directories and machines
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+      if((CMAKE_CXX_COMPILER_ID STREQUAL "GNU"
+            AND NOT CMAKE_CXX_COMPILER_VERSION VERSION_LESS 8)
+          OR (CMAKE_CXX_COMPILER_ID STREQUAL "Clang"
+            AND NOT CMAKE_CXX_COMPILER_VERSION VERSION_LESS 10)
+          OR (CMAKE_CXX_COMPILER_ID STREQUAL "AppleClang"
+            AND NOT CMAKE_CXX_COMPILER_VERSION VERSION_LESS 12))
+        set(prefix_map_flag "-ffile-prefix-map")
+      else()
+        set(prefix_map_flag "-fdebug-prefix-map")
+      endif()
+      target_compile_options(${settings_target} INTERFACE
+        "${prefix_map_flag}=${CMAKE_SOURCE_DIR}=."
+      )
+      foreach(dir "${CMAKE_BINARY_DIR}" ${JUCER_PROJECT_MODULES_FOLDERS})
+        string(FIND "${dir}/" "${CMAKE_SOURCE_DIR}/" source_dir_pos)
+        if(NOT source_dir_pos EQUAL 0)
+          file(RELATIVE_PATH relative_dir "${CMAKE_SOURCE_DIR}" "${dir}")
+          target_compile_options(${settings_target} INTERFACE
+            "${prefix_map_flag}=${dir}=${relative_dir}"
+          )
+        endif()
+      endforeach()
+    endif()
+  endif()
+
+  target_compile_options(${settings_target} INTERFACE ${JUCER_EXTRA_COMPILER_FLAGS})
+  target_link_libraries(${settings_target} INTERFACE ${JUCER_EXTRA_LINKER_FLAGS})
+
+  _FRUT_profile_end(_FRUT_add_project_settings_target)
+
+endfunction()
+
+
+function(_FRUT_get_project_settings_target out_target)
+
+  string(REGEX REPLACE "[^A-Za-z0-9_.+-]" "_" target "${JUCER_PROJECT_NAME}")
+  set(${out_target} "${target}_settings" PARENT_SCOPE)
+
+endfunction()
+
+
+function(_FRUT_set_common_target_properties target)
+
+  _FRUT_profile_begin(_FRUT_set_common_target_properties)
+
+  foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+    string(TOUPPER "${config}" upper_config)
+
+    if(JUCER_BINARY_NAME_${config})
+      set(output_name "${JUCER_BINARY_NAME_${config}}")
+    else()
+      set(output_name "${JUCER_PROJECT_NAME}")
+    endif()
+    set_target_properties(${target} PROPERTIES
+      OUTPUT_NAME_${upper_config} "${output_name}"
+    )
+  endforeach()
+
+  _FRUT_get_project_settings_target(settings_target)
+  target_link_libraries(${target} PRIVATE ${settings_target})
+
+  # Makes sure that the BinaryData files are generated only once, before the targets
+  # that list them or include them are compiled
+  if(DEFINED JUCER_BINARY_DATA_TARGET)
+    add_dependencies(${target} ${JUCER_BINARY_DATA_TARGET})
+  endif()
+
+  _FRUT_set_cxx_language_standard_properties(${target})
+
+  if(APPLE)
     if(target MATCHES "_AUv3_AppExtension$")
       if(CMAKE_GENERATOR STREQUAL "Xcode")
         set_target_properties(${target} PROPERTIES
@@ -2496,34 +4168,39 @@ function(_FRUT_set_common_target_properties target)
         XCODE_ATTRIBUTE_SDKROOT "${all_confs_sdkroot}"
       )
     else()
-      set(osx_deployment_target "10.11")
-      if(DEFINED ${JUCER_OSX_DEPLOYMENT_TARGET_${CMAKE_BUILD_TYPE}})
-        set(osx_deployment_target "${JUCER_OSX_DEPLOYMENT_TARGET_${CMAKE_BUILD_TYPE}}")
-      endif()
-      if(target MATCHES "_AUv3_AppExtension$"
-          AND osx_deployment_target VERSION_LESS 10.11)
+      _FRUT_get_built_configurations(built_configs)
+      foreach(config ${built_configs})
         set(osx_deployment_target "10.11")
-        message(STATUS "Set OSX Deployment Target to 10.11 for ${target}")
-      endif()
-      target_compile_options(${target} PRIVATE
-        "-mmacosx-version-min=${osx_deployment_target}"
-      )
-
-      set(sdkroot "${JUCER_OSX_BASE_SDK_VERSION_${CMAKE_BUILD_TYPE}}")
-      if(sdkroot)
-        execute_process(
-          COMMAND "xcrun" "--sdk" "macosx${sdkroot}" "--show-sdk-path"
-          OUTPUT_VARIABLE sysroot
-          OUTPUT_STRIP_TRAILING_WHITESPACE
+        if(DEFINED JUCER_OSX_DEPLOYMENT_TARGET_${config})
+          set(osx_deployment_target "${JUCER_OSX_DEPLOYMENT_TARGET_${config}}")
+        endif()
+        if(target MATCHES "_AUv3_AppExtension$"
+            AND osx_deployment_target VERSION_LESS 10.11)
+          set(osx_deployment_target "10.11")
+          message(STATUS "Set OSX Deployment Target to 10.11 for ${target} in ${config}")
+        endif()
+        target_compile_options(${target} PRIVATE
+          $<$<CONFIG:${config}>:-mmacosx-version-min=${osx_deployment_target}>
         )
-        if(IS_DIRECTORY "${sysroot}")
-          target_compile_options(${target} PRIVATE "-isysroot ${sysroot}")
-        else()
-          message(WARNING "Running `xcrun --sdk macosx${sdkroot} --show-sdk-path` didn't"
-            " output a valid directory."
+
+        set(sdkroot "${JUCER_OSX_BASE_SDK_VERSION_${config}}")
+        if(sdkroot)
+          execute_process(
+            COMMAND "xcrun" "--sdk" "macosx${sdkroot}" "--show-sdk-path"
+            OUTPUT_VARIABLE sysroot
+            OUTPUT_STRIP_TRAILING_WHITESPACE
           )
+          if(IS_DIRECTORY "${sysroot}")
+            target_compile_options(${target} PRIVATE
+              "$<$<CONFIG:${config}>:-isysroot ${sysroot}>"
+            )
+          else()
+            message(WARNING "Running `xcrun --sdk macosx${sdkroot} --show-sdk-path`"
+              " didn't output a valid directory."
+            )
+          endif()
         endif()
-      endif()
+      endforeach()
     endif()
 
     unset(all_confs_code_sign_identity)
@@ -2590,96 +4267,22 @@ function(_FRUT_set_common_target_properties target)
       if(NOT IS_DIRECTORY "${JUCER_TARGET_PROJECT_FOLDER}")
         file(MAKE_DIRECTORY "${JUCER_TARGET_PROJECT_FOLDER}")
       endif()
-      add_custom_command(TARGET ${target} POST_BUILD
-        COMMAND "/bin/sh" "${JUCER_POSTBUILD_SHELL_SCRIPT}"
-        WORKING_DIRECTORY "${JUCER_TARGET_PROJECT_FOLDER}"
-      )
-    endif()
-
-    if(CMAKE_GENERATOR STREQUAL "Xcode" AND DEFINED JUCER_USE_HEADERMAP)
-      if(JUCER_USE_HEADERMAP)
-        set_target_properties(${target} PROPERTIES XCODE_ATTRIBUTE_USE_HEADERMAP "YES")
-      else()
-        set_target_properties(${target} PROPERTIES XCODE_ATTRIBUTE_USE_HEADERMAP "NO")
-      endif()
-    endif()
-
-  elseif(MSVC)
-    target_compile_definitions(${target} PRIVATE "_CRT_SECURE_NO_WARNINGS")
-    target_compile_options(${target} PRIVATE "/MP")
-
-    foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
-      if(${JUCER_CONFIGURATION_IS_DEBUG_${config}})
-        target_compile_definitions(${target} PRIVATE
-          $<$<CONFIG:${config}>:DEBUG>
-          $<$<CONFIG:${config}>:_DEBUG>
-        )
-      else()
-        target_compile_definitions(${target} PRIVATE
-          $<$<CONFIG:${config}>:NDEBUG>
-        )
-
-        if(NOT JUCER_ALWAYS_DISABLE_WPO_${config})
-          target_compile_options(${target} PRIVATE
-            $<$<CONFIG:${config}>:/GL>
-          )
-        endif()
-      endif()
-
-      if(NOT DEFINED JUCER_CHARACTER_SET_${config}
-          OR JUCER_CHARACTER_SET_${config} STREQUAL "Default")
-        target_compile_definitions(${target} PRIVATE
-          $<$<CONFIG:${config}>:_SBCS>
-        )
-      elseif(JUCER_CHARACTER_SET_${config} STREQUAL "MultiByte")
-        # Nothing to do, this is CMake's default
-      elseif(JUCER_CHARACTER_SET_${config} STREQUAL "Unicode")
-        target_compile_definitions(${target} PRIVATE
-          $<$<CONFIG:${config}>:_UNICODE>
-          $<$<CONFIG:${config}>:UNICODE>
-        )
-      endif()
-
-      if(DEFINED JUCER_RUNTIME_LIBRARY_FLAG_${config})
-        set(runtime_library_flag ${JUCER_RUNTIME_LIBRARY_FLAG_${config}})
-      elseif(JUCER_BUILD_VST OR JUCER_BUILD_VST3)
-        if(JUCER_CONFIGURATION_IS_DEBUG_${config})
-          set(runtime_library_flag "/MDd")
-        else()
-          set(runtime_library_flag "/MD")
-        endif()
-      else()
-        if(JUCER_CONFIGURATION_IS_DEBUG_${config})
-          set(runtime_library_flag "/MTd")
-        else()
-          set(runtime_library_flag "/MT")
-        endif()
-      endif()
-      target_compile_options(${target} PRIVATE
-        $<$<CONFIG:${config}>:${runtime_library_flag}>
-      )
-
-      if(DEFINED JUCER_WARNING_LEVEL_FLAG_${config})
-        set(warning_level_flag ${JUCER_WARNING_LEVEL_FLAG_${config}})
-      else()
-        set(warning_level_flag "/W4")
-      endif()
-      target_compile_options(${target} PRIVATE
-        $<$<CONFIG:${config}>:${warning_level_flag}>
+      add_custom_command(TARGET ${target} POST_BUILD
+        COMMAND "/bin/sh" "${JUCER_POSTBUILD_SHELL_SCRIPT}"
+        WORKING_DIRECTORY "${JUCER_TARGET_PROJECT_FOLDER}"
       )
+    endif()
 
-      if(JUCER_TREAT_WARNINGS_AS_ERRORS_${config})
-        target_compile_options(${target} PRIVATE $<$<CONFIG:${config}>:/WX>)
-      endif()
-
-      if(JUCER_RELAX_IEEE_COMPLIANCE_${config})
-        target_compile_options(${target} PRIVATE $<$<CONFIG:${config}>:/fp:fast>)
+    if(CMAKE_GENERATOR STREQUAL "Xcode" AND DEFINED JUCER_USE_HEADERMAP)
+      if(JUCER_USE_HEADERMAP)
+        set_target_properties(${target} PROPERTIES XCODE_ATTRIBUTE_USE_HEADERMAP "YES")
+      else()
+        set_target_properties(${target} PROPERTIES XCODE_ATTRIBUTE_USE_HEADERMAP "NO")
       endif()
+    endif()
 
-      foreach(path ${JUCER_EXTRA_LIBRARY_SEARCH_PATHS_${config}})
-        target_link_libraries(${target} PRIVATE $<$<CONFIG:${config}>:-LIBPATH:${path}>)
-      endforeach()
-
+  elseif(MSVC)
+    foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
       if(DEFINED JUCER_INCREMENTAL_LINKING_${config})
         if(JUCER_INCREMENTAL_LINKING_${config})
           string(TOUPPER "${config}" upper_config)
@@ -2748,69 +4351,604 @@ function(_FRUT_set_common_target_properties target)
     endif()
 
   elseif(CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux")
-    foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
-      if(${JUCER_CONFIGURATION_IS_DEBUG_${config}})
-        target_compile_definitions(${target} PRIVATE
-          $<$<CONFIG:${config}>:DEBUG=1>
-          $<$<CONFIG:${config}>:_DEBUG=1>
-        )
-      else()
-        target_compile_definitions(${target} PRIVATE
-          $<$<CONFIG:${config}>:NDEBUG=1>
+    if(JUCER_PLUGIN_LOAD_TIME_OPTIMISATION AND JUCER_PROJECT_TYPE STREQUAL "Audio Plug-in")
+      _FRUT_set_plugin_load_time_optimisation_properties(${target})
+    endif()
+
+    get_target_property(target_type ${target} TYPE)
+    if(target_type MATCHES "^(EXECUTABLE|MODULE_LIBRARY|SHARED_LIBRARY)$")
+      unset(all_confs_separate_debug_symbols)
+      foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+        if(JUCER_SEPARATE_DEBUG_SYMBOLS_${config})
+          string(APPEND all_confs_separate_debug_symbols $<$<CONFIG:${config}>:ON>)
+        endif()
+      endforeach()
+      if(all_confs_separate_debug_symbols)
+        if(NOT CMAKE_OBJCOPY)
+          message(FATAL_ERROR "Could not find objcopy program")
+        endif()
+        add_custom_command(TARGET ${target} POST_BUILD
+          COMMAND
+          "${CMAKE_COMMAND}"
+          "-Denabled=${all_confs_separate_debug_symbols}"
+          "-Dobjcopy=${CMAKE_OBJCOPY}"
+          "-Dbinary_file=$<TARGET_FILE:${target}>"
+          "-P" "${Reprojucer_templates_DIR}/separate-debug-symbols.cmake"
+          VERBATIM
         )
       endif()
+    endif()
 
-      if(DEFINED JUCER_ARCHITECTURE_FLAG_${config})
-        set(architecture_flag ${JUCER_ARCHITECTURE_FLAG_${config}})
-      else()
-        set(architecture_flag "-march=native")
+  endif()
+
+  _FRUT_set_compiler_launcher_properties(${target})
+
+  _FRUT_add_multi_isa_check(${target})
+
+  _FRUT_profile_end(_FRUT_set_common_target_properties)
+
+endfunction()
+
+
+function(_FRUT_get_linux_package_targets out_targets)
+
+  set(linux_packages ${JUCER_PROJECT_LINUX_PACKAGES} ${JUCER_PKGCONFIG_LIBRARIES})
+  if(NOT linux_packages)
+    set(${out_targets} "" PARENT_SCOPE)
+    return()
+  endif()
+
+  _FRUT_profile_begin(_FRUT_get_linux_package_targets)
+
+  list(SORT linux_packages)
+  list(REMOVE_DUPLICATES linux_packages)
+  set(package_targets "")
+  foreach(pkg ${linux_packages})
+    # pkg-config is only queried once per package, and the plugin format targets share
+    # the resulting imported target
+    set(package_target "FRUT::PkgConfig::${pkg}")
+    if(NOT TARGET ${package_target})
+      _FRUT_profile_begin(pkg_check_modules)
+      find_package(PkgConfig REQUIRED)
+      pkg_check_modules(${pkg} "${pkg}")
+      _FRUT_profile_end(pkg_check_modules "${pkg}")
+      if(NOT ${pkg}_FOUND)
+        message(FATAL_ERROR "pkg-config could not find ${pkg}")
       endif()
-      target_compile_options(${target} PRIVATE
-        $<$<CONFIG:${config}>:${architecture_flag}>
+      add_library(${package_target} INTERFACE IMPORTED)
+      set_target_properties(${package_target} PROPERTIES
+        INTERFACE_COMPILE_OPTIONS "${${pkg}_CFLAGS}"
+        INTERFACE_LINK_LIBRARIES "${${pkg}_LIBRARIES}"
       )
+    endif()
+    list(APPEND package_targets ${package_target})
+  endforeach()
 
-      foreach(path ${JUCER_EXTRA_LIBRARY_SEARCH_PATHS_${config}})
-        target_link_libraries(${target} PRIVATE $<$<CONFIG:${config}>:-L${path}>)
-      endforeach()
-    endforeach()
+  set(${out_targets} ${package_targets} PARENT_SCOPE)
 
-    set(linux_packages ${JUCER_PROJECT_LINUX_PACKAGES} ${JUCER_PKGCONFIG_LIBRARIES})
-    if(linux_packages)
-      find_package(PkgConfig REQUIRED)
-      list(SORT linux_packages)
-      list(REMOVE_DUPLICATES linux_packages)
-      foreach(pkg ${linux_packages})
-        pkg_check_modules(${pkg} "${pkg}")
-        if(NOT ${pkg}_FOUND)
-          message(FATAL_ERROR "pkg-config could not find ${pkg}")
-        endif()
-        target_compile_options(${target} PRIVATE ${${pkg}_CFLAGS})
-        target_link_libraries(${target} PRIVATE ${${pkg}_LIBRARIES})
-      endforeach()
+  _FRUT_profile_end(_FRUT_get_linux_package_targets)
+
+endfunction()
+
+
+function(_FRUT_set_plugin_load_time_optimisation_properties target)
+
+  target_compile_options(${target} PRIVATE
+    "-fvisibility=hidden"
+    "-fvisibility-inlines-hidden"
+    "-ffunction-sections"
+    "-fdata-sections"
+  )
+
+  get_target_property(target_type ${target} TYPE)
+  if(target_type STREQUAL "STATIC_LIBRARY")
+    return()
+  endif()
+
+  target_link_libraries(${target} PRIVATE "-Wl,--gc-sections")
+
+  if(target_type STREQUAL "MODULE_LIBRARY")
+    target_link_libraries(${target} PRIVATE "-Wl,-Bsymbolic")
+
+    # Only the entry points that hosts look up with dlsym() are exported
+    if(target MATCHES "_VST3$")
+      set(exported_symbols "GetPluginFactory" "ModuleEntry" "ModuleExit")
     else()
-      if("juce_graphics" IN_LIST JUCER_PROJECT_MODULES)
-        target_include_directories(${target} PRIVATE "/usr/include/freetype2")
+      set(exported_symbols "VSTPluginMain" "main")
+    endif()
+    unset(exported_symbols_list)
+    foreach(symbol ${exported_symbols})
+      string(APPEND exported_symbols_list "    ${symbol};\n")
+    endforeach()
+    set(version_script "${CMAKE_CURRENT_BINARY_DIR}/${target}_exports.map")
+    configure_file("${Reprojucer_templates_DIR}/exports.map" "${version_script}" @ONLY)
+    target_link_libraries(${target} PRIVATE "-Wl,--version-script=${version_script}")
+    set_property(TARGET ${target} APPEND PROPERTY LINK_DEPENDS "${version_script}")
+
+    # GNU ld (the default linker) doesn't support identical code folding
+    foreach(config ${JUCER_PROJECT_CONFIGURATIONS})
+      if(DEFINED JUCER_LINKER_${config} AND NOT JUCER_LINKER_${config} STREQUAL "default")
+        target_link_libraries(${target} PRIVATE $<$<CONFIG:${config}>:-Wl,--icf=all>)
       endif()
-      if(JUCER_FLAG_JUCE_USE_CURL)
-        target_link_libraries(${target} PRIVATE "-lcurl")
+    endforeach()
+  endif()
+
+endfunction()
+
+
+function(_FRUT_get_profile_guided_optimisation_flags config out_flags)
+
+  if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU"
+      AND CMAKE_CXX_COMPILER_VERSION VERSION_LESS 11)
+    message(FATAL_ERROR "PROFILE_GUIDED_OPTIMISATION requires GCC 11 or later, or Clang")
+  endif()
+
+  set(pgo_dir "${CMAKE_CURRENT_BINARY_DIR}/ProfileGuidedOptimisation/${config}")
+
+  # The instrumented variant is a nested build of the project, configured by the
+  # <target>_PGO_Training target with _FRUT_PGO_PROFILE_DIR, _FRUT_PGO_CONFIG and
+  # _FRUT_PGO_BINARY_DIR
+  if(DEFINED _FRUT_PGO_PROFILE_DIR AND config STREQUAL _FRUT_PGO_CONFIG)
+    set(flags "-fprofile-generate=${_FRUT_PGO_PROFILE_DIR}")
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+      # Plug-ins run on several threads, and the profile data must match the objects of
+      # the outer build, which live in another build directory. By default, GCC
+      # identifies the functions with internal linkage with the path of their object
+      list(APPEND flags
+        "-fprofile-update=prefer-atomic"
+        "-fprofile-prefix-path=${CMAKE_CURRENT_BINARY_DIR}"
+        "--param=profile-func-internal-id=1"
+      )
+    endif()
+  elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    if(EXISTS "${pgo_dir}/default.profdata")
+      set(flags "-fprofile-use=${pgo_dir}/default.profdata")
+    endif()
+  else()
+    file(GLOB profile_data_files "${pgo_dir}/Data/*.gcda")
+    if(profile_data_files)
+      set(flags
+        "-fprofile-use=${pgo_dir}/Data"
+        "-fprofile-prefix-path=${CMAKE_CURRENT_BINARY_DIR}"
+        "--param=profile-func-internal-id=1"
+        "-Wno-missing-profile"
+      )
+    endif()
+  endif()
+
+  set(${out_flags} ${flags} PARENT_SCOPE)
+
+endfunction()
+
+
+function(_FRUT_add_profile_guided_optimisation_training_target target)
+
+  unset(pgo_configs)
+  _FRUT_get_built_configurations(built_configs)
+  foreach(config ${built_configs})
+    if(JUCER_PROFILE_GUIDED_OPTIMISATION_${config})
+      list(APPEND pgo_configs ${config})
+    endif()
+  endforeach()
+  if(NOT pgo_configs)
+    return()
+  endif()
+
+  # Both the project and its instrumented build list their objects, so that the .gcda
+  # files of the instrumented build can be renamed after the objects of the project
+  if(NOT CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    if(CMAKE_VERSION VERSION_LESS 3.9)
+      message(FATAL_ERROR "PROFILE_GUIDED_OPTIMISATION with GCC requires at least CMake"
+        " version 3.9"
+      )
+    endif()
+    set(objects "")
+    get_property(directory_targets DIRECTORY PROPERTY BUILDSYSTEM_TARGETS)
+    foreach(directory_target ${directory_targets})
+      get_target_property(target_type ${directory_target} TYPE)
+      if(target_type MATCHES "^(EXECUTABLE|(STATIC|SHARED|MODULE|OBJECT)_LIBRARY)$")
+        string(APPEND objects "${directory_target}|$<JOIN:"
+          "$<TARGET_OBJECTS:${directory_target}>,\n${directory_target}|>\n"
+        )
       endif()
+    endforeach()
+    file(GENERATE
+      OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/ProfileGuidedOptimisation/objects-$<CONFIG>.txt"
+      CONTENT "${objects}"
+    )
+  endif()
+
+  if(DEFINED _FRUT_PGO_PROFILE_DIR)
+    return()
+  endif()
+
+  foreach(config ${pgo_configs})
+    _FRUT_add_profile_guided_optimisation_training_target_for_config(${target} ${config})
+  endforeach()
+
+endfunction()
+
+
+function(_FRUT_add_profile_guided_optimisation_training_target_for_config target config)
+
+  # With a multi-configuration generator, each configuration has its own training
+  if(DEFINED CMAKE_CONFIGURATION_TYPES)
+    set(training_target ${target}_PGO_Training_${config})
+  else()
+    set(training_target ${target}_PGO_Training)
+  endif()
+
+  set(pgo_dir "${CMAKE_CURRENT_BINARY_DIR}/ProfileGuidedOptimisation/${config}")
+  set(instrumented_build_dir "${pgo_dir}/InstrumentedBuild")
+  set(profile_data_dir "${pgo_dir}/Data")
+  set(stamp_file "${pgo_dir}/profile.stamp")
+
+  file(MAKE_DIRECTORY "${instrumented_build_dir}")
+  if(NOT EXISTS "${stamp_file}")
+    file(WRITE "${stamp_file}" "")
+  endif()
+  # Training touches the stamp file, which reconfigures the project with -fprofile-use
+  # and rebuilds all its sources (in all the configurations, since OBJECT_DEPENDS cannot
+  # depend on the configuration)
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${stamp_file}")
+  set_property(SOURCE ${JUCER_PROJECT_SOURCES}
+    APPEND PROPERTY OBJECT_DEPENDS "${stamp_file}"
+  )
+
+  _FRUT_get_profile_guided_optimisation_flags("${config}" pgo_flags)
+  if(NOT pgo_flags)
+    message(STATUS "No profile data for the ${config} configuration yet, build the "
+      "${training_target} target to generate it"
+    )
+  endif()
+
+  unset(merge_command)
+  if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    get_filename_component(compiler_dir "${CMAKE_CXX_COMPILER}" DIRECTORY)
+    string(REGEX MATCH "^[0-9]+" compiler_major_version "${CMAKE_CXX_COMPILER_VERSION}")
+    find_program(llvm_profdata_exe
+      NAMES "llvm-profdata" "llvm-profdata-${compiler_major_version}"
+      HINTS "${compiler_dir}"
+    )
+    if(NOT llvm_profdata_exe)
+      message(FATAL_ERROR "Could not find llvm-profdata")
     endif()
+    set(raw_profile_dir "${profile_data_dir}")
+    set(profile_data_file "${pgo_dir}/default.profdata")
+    configure_file("${Reprojucer_templates_DIR}/merge-profile-data.cmake"
+      "${pgo_dir}/merge-profile-data.cmake" @ONLY
+    )
+    set(merge_command
+      COMMAND "${CMAKE_COMMAND}" "-P" "${pgo_dir}/merge-profile-data.cmake"
+    )
+  else()
+    set(instrumented_objects_file
+      "${instrumented_build_dir}/ProfileGuidedOptimisation/objects-${config}.txt"
+    )
+    set(objects_file
+      "${CMAKE_CURRENT_BINARY_DIR}/ProfileGuidedOptimisation/objects-${config}.txt"
+    )
+    set(build_dir "${CMAKE_CURRENT_BINARY_DIR}")
+    configure_file("${Reprojucer_templates_DIR}/rename-profile-data.cmake"
+      "${pgo_dir}/rename-profile-data.cmake" @ONLY
+    )
+    set(merge_command
+      COMMAND "${CMAKE_COMMAND}" "-P" "${pgo_dir}/rename-profile-data.cmake"
+    )
+  endif()
 
-    set(linux_libs ${JUCER_PROJECT_LINUX_LIBS})
-    if(linux_libs)
-      list(SORT linux_libs)
-      list(REMOVE_DUPLICATES linux_libs)
-      foreach(item ${linux_libs})
-        if(item STREQUAL "pthread")
-          target_compile_options(${target} PRIVATE "-pthread")
-        endif()
-        target_link_libraries(${target} PRIVATE "-l${item}")
-      endforeach()
+  # The instrumented build only configures the directory of the project, even when it is
+  # part of a larger tree, so it gets the cache entries of the outer build (e.g. the
+  # paths given on the command line), and the <project>_jucer_FILE variable that the
+  # parent directory of a project written by Jucer2Reprojucer defines
+  set(initial_cache "")
+  get_property(cache_variables DIRECTORY PROPERTY CACHE_VARIABLES)
+  foreach(variable ${cache_variables})
+    get_property(type CACHE "${variable}" PROPERTY TYPE)
+    if(type STREQUAL "INTERNAL" OR type STREQUAL "STATIC"
+        OR variable MATCHES "^(CMAKE_BUILD_TYPE|_FRUT_PGO_.*)$")
+      continue()
+    endif()
+    if(type STREQUAL "UNINITIALIZED")
+      set(type "STRING")
+    endif()
+    get_property(value CACHE "${variable}" PROPERTY VALUE)
+    get_property(help_string CACHE "${variable}" PROPERTY HELPSTRING)
+    string(APPEND initial_cache
+      "set(${variable} [==[${value}]==] CACHE ${type} [==[${help_string}]==])\n"
+    )
+  endforeach()
+  if(DEFINED ${PROJECT_NAME}_jucer_FILE)
+    string(APPEND initial_cache "set(${PROJECT_NAME}_jucer_FILE "
+      "[==[${${PROJECT_NAME}_jucer_FILE}]==] CACHE FILEPATH \"\")\n"
+    )
+  endif()
+  set(initial_cache_file "${pgo_dir}/InitialCache.cmake")
+  file(WRITE "${initial_cache_file}" "${initial_cache}")
+
+  set(configure_args
+    "-C" "${initial_cache_file}"
+    "-G" "${CMAKE_GENERATOR}"
+    "-DCMAKE_BUILD_TYPE=${config}"
+    "-D_FRUT_PGO_PROFILE_DIR=${profile_data_dir}"
+    "-D_FRUT_PGO_CONFIG=${config}"
+    "-D_FRUT_PGO_BINARY_DIR=${CMAKE_CURRENT_BINARY_DIR}"
+  )
+
+  add_custom_target(${training_target}
+    COMMAND "${CMAKE_COMMAND}" "-E" "remove_directory" "${profile_data_dir}"
+    COMMAND "${CMAKE_COMMAND}" ${configure_args} "${CMAKE_CURRENT_SOURCE_DIR}"
+    COMMAND "${CMAKE_COMMAND}" "--build" "." "--config" "${config}"
+    COMMAND ${JUCER_PROFILE_TRAINING_COMMAND_${config}}
+    ${merge_command}
+    COMMAND "${CMAKE_COMMAND}" "-E" "touch" "${stamp_file}"
+    WORKING_DIRECTORY "${instrumented_build_dir}"
+    COMMENT "Training ${target} for profile-guided optimisation in ${config}"
+    VERBATIM
+  )
+
+endfunction()
+
+
+function(_FRUT_add_vectorisation_report_target target)
+
+  if(NOT JUCER_VECTORISATION_REPORT)
+    return()
+  endif()
+
+  if(JUCER_PROJECT_TYPE STREQUAL "Audio Plug-in")
+    set(sources_target ${target}_Shared_Code)
+  else()
+    set(sources_target ${target})
+  endif()
+
+  if(DEFINED JUCER_PROJECT_DIR)
+    set(source_dir "${JUCER_PROJECT_DIR}")
+  else()
+    set(source_dir "${CMAKE_CURRENT_SOURCE_DIR}")
+  endif()
+
+  # Only the source files of the project, not the JUCE modules nor BinaryData
+  unset(user_sources)
+  foreach(src_file ${JUCER_PROJECT_SOURCES})
+    get_source_file_property(is_header_file "${src_file}" HEADER_FILE_ONLY)
+    string(FIND "${src_file}" "${JUCER_LIBRARY_CODE_DIR}/" pos)
+    if(src_file MATCHES "\\.(c|cc|cpp|cxx)$" AND NOT is_header_file AND NOT pos EQUAL 0)
+      list(APPEND user_sources "${src_file}")
+    endif()
+  endforeach()
+  if(NOT user_sources)
+    message(WARNING "VECTORISATION_REPORT: the project doesn't have any source file")
+    return()
+  endif()
+
+  set(report_dir "${CMAKE_CURRENT_BINARY_DIR}/VectorisationReport")
+  set(remarks_dir "${report_dir}/Remarks")
+  file(MAKE_DIRECTORY "${remarks_dir}")
+
+  # The source files are compiled again (only when building the report target), with a
+  # compiler launcher that saves the vectorisation remarks of the compiler
+  set(remarks_target ${target}_Vectorisation_Remarks)
+  add_library(${remarks_target} OBJECT EXCLUDE_FROM_ALL ${user_sources})
+  _FRUT_set_object_library_properties(${remarks_target} ${sources_target})
+  foreach(lang "C" "CXX")
+    set(launcher
+      "${CMAKE_COMMAND}"
+      "-Dcompiler_id=${CMAKE_${lang}_COMPILER_ID}"
+      "-Dsource_dir=${source_dir}"
+      "-Dremarks_dir=${remarks_dir}"
+      "-P" "${Reprojucer_templates_DIR}/vectorisation-remarks.cmake"
+      "--"
+    )
+    set_target_properties(${remarks_target} PROPERTIES
+      ${lang}_COMPILER_LAUNCHER "${launcher}"
+    )
+  endforeach()
+
+  set(report_file "${report_dir}/VectorisationReport.txt")
+  configure_file("${Reprojucer_templates_DIR}/vectorisation-report.cmake"
+    "${report_dir}/vectorisation-report.cmake" @ONLY
+  )
+  add_custom_target(${target}_Vectorisation_Report
+    COMMAND "${CMAKE_COMMAND}" "-P" "${report_dir}/vectorisation-report.cmake"
+    COMMENT "Collecting the vectorisation remarks of ${target}"
+    VERBATIM
+  )
+  add_dependencies(${target}_Vectorisation_Report ${remarks_target})
+
+endfunction()
+
+
+function(_FRUT_add_build_report_target target)
+
+  # The Ninja generators leave <TARGET_NAME> as is in custom commands, and also launch
+  # the regeneration of the build system with RULE_LAUNCH_CUSTOM
+  if(NOT CMAKE_GENERATOR MATCHES "Makefiles")
+    message(FATAL_ERROR "FRUT_BUILD_TELEMETRY is only supported with the Makefile "
+      "generators"
+    )
+  endif()
+  if(CMAKE_HOST_WIN32)
+    message(FATAL_ERROR "FRUT_BUILD_TELEMETRY is not supported on Windows")
+  endif()
+
+  _FRUT_get_frut_tools_exe(frut_tools_exe)
+
+  # All the projects of the build tree share the same records and report
+  set(telemetry_dir "${CMAKE_BINARY_DIR}/BuildTelemetry")
+  set(records_file "${telemetry_dir}/records.tsv")
+  set(report_file "${telemetry_dir}/BuildReport.txt")
+  file(MAKE_DIRECTORY "${telemetry_dir}")
+
+  # frut-tools runs each compile, link and custom command of the targets of the project,
+  # and records its start, end, peak resident set size and exit code. The launchers are
+  # set on these targets only, so that the other targets of the directory are left alone.
+  set(project_targets "")
+  foreach(suffix "" "_Shared_Code" "_VST" "_VST3" "_AU" "_AUv3_AppExtension"
+      "_AUv3_Standalone" "_StandalonePlugin" "_BinaryData" "_JuceLibraryCode" "_x86_64")
+    if(TARGET ${target}${suffix})
+      list(APPEND project_targets ${target}${suffix})
+    endif()
+  endforeach()
+  get_property(multi_isa_variants GLOBAL PROPERTY FRUT_MULTI_ISA_VARIANTS_${target})
+  list(APPEND project_targets ${multi_isa_variants})
+
+  set(launcher "\"${frut_tools_exe}\" build-telemetry \"${records_file}\"")
+  set_target_properties(${project_targets} PROPERTIES
+    RULE_LAUNCH_COMPILE "${launcher} compile <TARGET_NAME> <SOURCE> --"
+    RULE_LAUNCH_LINK "${launcher} link <TARGET_NAME> <TARGET> --"
+    RULE_LAUNCH_CUSTOM "${launcher} custom <TARGET_NAME> <OUTPUT> --"
+  )
+
+  if(NOT TARGET frut_build_report)
+    add_custom_target(frut_build_report
+      COMMAND "${frut_tools_exe}" "build-report" "${records_file}" "${report_file}"
+      COMMENT "Writing the build report to ${report_file}"
+      VERBATIM
+    )
+  endif()
+
+  # Building frut_build_report builds the project first, so that the report covers it
+  _FRUT_add_dependencies_on_project_targets(frut_build_report ${target})
+
+endfunction()
+
+
+function(_FRUT_add_compile_time_report_target target)
+
+  set(report_dir "${CMAKE_CURRENT_BINARY_DIR}/CompileTimeReport")
+  set(traces_dir "${report_dir}/Traces")
+  file(MAKE_DIRECTORY "${traces_dir}")
+
+  # Each compiled source file is attributed to its JUCE module, to its group in
+  # jucer_project_files(), or to BinaryData. The compile-time-trace.cmake launcher names
+  # the trace of a source file after its absolute path.
+  set(units "")
+  foreach(src_file ${JUCER_PROJECT_SOURCES})
+    get_source_file_property(is_header_file "${src_file}" HEADER_FILE_ONLY)
+    if(is_header_file OR NOT src_file MATCHES "\\.(c|cc|cpp|cxx|m|mm)$")
+      continue()
+    endif()
+    get_source_file_property(module_name "${src_file}" FRUT_JUCE_MODULE)
+    get_source_file_property(source_group_name "${src_file}" FRUT_SOURCE_GROUP)
+    get_filename_component(src_file_name "${src_file}" NAME)
+    if(module_name)
+      set(kind "module")
+      set(name "${module_name}")
+    elseif(source_group_name)
+      set(kind "group")
+      set(name "${source_group_name}")
+    elseif(src_file_name MATCHES "^BinaryData")
+      set(kind "other")
+      set(name "BinaryData")
+    else()
+      set(kind "other")
+      set(name "${src_file_name}")
+    endif()
+    get_filename_component(src_file "${src_file}" ABSOLUTE)
+    string(MAKE_C_IDENTIFIER "${src_file}" source_file_identifier)
+    string(APPEND units "${kind}\t${name}\t${source_file_identifier}\t${src_file}\n")
+  endforeach()
+  set(units_file "${report_dir}/units.tsv")
+  file(WRITE "${units_file}" "${units}")
+
+  _FRUT_get_frut_tools_exe(frut_tools_exe)
+
+  set(report_file "${report_dir}/CompileTimeReport.txt")
+  add_custom_target(${target}_Compile_Time_Report
+    COMMAND "${frut_tools_exe}" "compile-time-report"
+    "${units_file}" "${traces_dir}" "${report_file}"
+    COMMENT "Writing the compile time report of ${target} to ${report_file}"
+    VERBATIM
+  )
+
+  # Building the report target builds the project first, so that the traces are current
+  _FRUT_add_dependencies_on_project_targets(${target}_Compile_Time_Report ${target})
+
+endfunction()
+
+
+function(_FRUT_add_dependencies_on_project_targets dependent_target target)
+
+  # The main target of the project, and the Shared Code and plugin format targets of
+  # "Audio Plug-in" projects
+  foreach(suffix "" "_Shared_Code" "_VST" "_VST3" "_AU" "_AUv3_AppExtension"
+      "_AUv3_Standalone" "_StandalonePlugin")
+    if(TARGET ${target}${suffix})
+      add_dependencies(${dependent_target} ${target}${suffix})
+    endif()
+  endforeach()
+
+endfunction()
+
+
+function(_FRUT_set_compiler_launcher_properties target)
+
+  if(NOT CMAKE_GENERATOR MATCHES "Makefiles|Ninja")
+    return()
+  endif()
+
+  unset(launcher)
+  if(DEFINED JUCER_COMPILER_CACHE)
+    _FRUT_get_compiler_cache_launcher(launcher)
+  endif()
+
+  foreach(lang "C" "CXX")
+    set(lang_launcher ${launcher})
+    if(FRUT_COMPILE_TIME_REPORT)
+      # The trace flag is added before the compiler cache sees the command, so that it is
+      # part of the cache key. A cache hit keeps the trace of the previous compilation.
+      set(lang_launcher
+        "${CMAKE_COMMAND}"
+        "-Dcompiler_id=${CMAKE_${lang}_COMPILER_ID}"
+        "-Dtraces_dir=${CMAKE_CURRENT_BINARY_DIR}/CompileTimeReport/Traces"
+        "-P" "${Reprojucer_templates_DIR}/compile-time-trace.cmake"
+        "--"
+        ${launcher}
+      )
+    endif()
+    if(lang_launcher)
+      set_target_properties(${target} PROPERTIES
+        ${lang}_COMPILER_LAUNCHER "${lang_launcher}"
+      )
+    endif()
+  endforeach()
+
+endfunction()
+
+
+function(_FRUT_get_compiler_cache_launcher out_launcher)
+
+  set(launcher "${JUCER_COMPILER_CACHE}")
+  get_filename_component(compiler_cache_name "${JUCER_COMPILER_CACHE}" NAME_WE)
+  if(compiler_cache_name STREQUAL "ccache")
+    # ccache rewrites the absolute paths below its base directory into relative ones
+    string(REPLACE "/" ";" source_dir_components "${CMAKE_SOURCE_DIR}")
+    string(REPLACE "/" ";" binary_dir_components "${CMAKE_BINARY_DIR}")
+    unset(base_dir)
+    list(LENGTH source_dir_components source_dir_components_count)
+    list(LENGTH binary_dir_components binary_dir_components_count)
+    set(index 0)
+    while(index LESS source_dir_components_count
+        AND index LESS binary_dir_components_count)
+      list(GET source_dir_components ${index} source_dir_component)
+      list(GET binary_dir_components ${index} binary_dir_component)
+      if(NOT source_dir_component STREQUAL binary_dir_component)
+        break()
+      endif()
+      if(index EQUAL 0)
+        set(base_dir "${source_dir_component}")
+      else()
+        set(base_dir "${base_dir}/${source_dir_component}")
+      endif()
+      math(EXPR index "${index} + 1")
+    endwhile()
+    if(NOT "${base_dir}" STREQUAL "")
+      set(launcher "${CMAKE_COMMAND}" -E env "CCACHE_BASEDIR=${base_dir}" ${launcher})
     endif()
   endif()
 
-  target_compile_options(${target} PRIVATE ${JUCER_EXTRA_COMPILER_FLAGS})
-  target_link_libraries(${target} PRIVATE ${JUCER_EXTRA_LINKER_FLAGS})
+  set(${out_launcher} "${launcher}" PARENT_SCOPE)
 
 endfunction()
 
@@ -2874,7 +5012,19 @@ function(_FRUT_set_cxx_language_standard_properties target)
         set_target_properties(${target} PROPERTIES CXX_EXTENSIONS OFF)
         set_target_properties(${target} PROPERTIES CXX_STANDARD 11)
 
-        set(cxx_language_standard "${JUCER_CXX_LANGUAGE_STANDARD_${CMAKE_BUILD_TYPE}}")
+        # CXX_STANDARD and CXX_EXTENSIONS cannot depend on the configuration
+        _FRUT_get_built_configurations(built_configs)
+        unset(cxx_language_standard)
+        foreach(config ${built_configs})
+          set(config_cxx_language_standard "${JUCER_CXX_LANGUAGE_STANDARD_${config}}")
+          if(NOT DEFINED cxx_language_standard)
+            set(cxx_language_standard "${config_cxx_language_standard}")
+          elseif(NOT config_cxx_language_standard STREQUAL cxx_language_standard)
+            message(FATAL_ERROR "CXX_LANGUAGE_STANDARD must be the same in all "
+              "configurations when using the ${CMAKE_GENERATOR} generator"
+            )
+          endif()
+        endforeach()
         if(cxx_language_standard)
           if(cxx_language_standard MATCHES "^GNU\\+\\+")
             set_target_properties(${target} PROPERTIES CXX_EXTENSIONS ON)
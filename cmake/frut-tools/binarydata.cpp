@@ -24,11 +24,11 @@
 #include <vector>
 
 
-int main(int argc, char* argv[])
+int binaryDataMain(int argc, char* argv[])
 {
   if (argc < 5)
   {
-    std::cerr << "usage: BinaryDataBuilder"
+    std::cerr << "usage: frut-tools binarydata"
               << " <BinaryData-files-output-dir>"
               << " <Project-UID>"
               << " <BinaryData.cpp-size-limit>"
@@ -0,0 +1,325 @@
+// Copyright (c) 2018 Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+struct Step
+{
+  std::string kind;
+  std::string targetName;
+  std::string name;
+  long long start;
+  long long end;
+  long long peakRssInKiB;
+  int exitCode;
+
+  long long getDuration() const
+  {
+    return end - start;
+  }
+};
+
+
+bool parseRecord(const std::string& line, Step& step)
+{
+  std::vector<std::string> fields;
+  std::istringstream lineStream{line};
+  std::string field;
+  while (std::getline(lineStream, field, '\t'))
+  {
+    fields.push_back(field);
+  }
+  if (fields.size() != 7)
+  {
+    return false;
+  }
+
+  step.kind = fields.at(0);
+  step.targetName = fields.at(1);
+  step.name = fields.at(2);
+  try
+  {
+    step.start = std::stoll(fields.at(3));
+    step.end = std::stoll(fields.at(4));
+    step.peakRssInKiB = std::stoll(fields.at(5));
+    step.exitCode = std::stoi(fields.at(6));
+  }
+  catch (const std::exception&)
+  {
+    return false;
+  }
+  return step.end >= step.start;
+}
+
+
+// Tells apart the JUCE modules, the BinaryData files and the user code, which are
+// compiled from the JuceLibraryCode folder of the build directory or from elsewhere
+std::string getCategory(const Step& step)
+{
+  if (step.kind == "link")
+  {
+    return "Link";
+  }
+  if (step.kind != "compile")
+  {
+    return "Custom commands";
+  }
+
+  const auto juceLibraryCodePos = step.name.find("JuceLibraryCode");
+  if (juceLibraryCodePos == std::string::npos)
+  {
+    return "User code";
+  }
+
+  const auto fileName = step.name.substr(step.name.find_last_of("/\\") + 1);
+  if (fileName.compare(0, 10, "BinaryData") == 0)
+  {
+    return "BinaryData";
+  }
+  return "JUCE modules";
+}
+
+
+std::string formatSeconds(long long microseconds)
+{
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(3) << microseconds / 1000000.0;
+  return stream.str();
+}
+
+
+std::string formatMiB(long long kibibytes)
+{
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(1) << kibibytes / 1024.0;
+  return stream.str();
+}
+
+
+// The build system doesn't tell which steps a step depends on, so the critical path is
+// estimated by going back from the step that ends last to the step that ended last before
+// it started, which is the one it most likely waited for
+std::vector<const Step*> getCriticalPath(const std::vector<Step>& steps)
+{
+  std::vector<const Step*> stepsByEnd;
+  for (const auto& step : steps)
+  {
+    stepsByEnd.push_back(&step);
+  }
+  std::sort(stepsByEnd.begin(), stepsByEnd.end(), [](const Step* lhs, const Step* rhs) {
+    return lhs->end < rhs->end;
+  });
+
+  std::vector<const Step*> criticalPath;
+  if (stepsByEnd.empty())
+  {
+    return criticalPath;
+  }
+
+  criticalPath.push_back(stepsByEnd.back());
+  while (true)
+  {
+    const auto start = criticalPath.back()->start;
+    const auto nextIt = std::lower_bound(stepsByEnd.begin(), stepsByEnd.end(), start,
+                                         [](const Step* step, long long time) {
+                                           return step->end < time;
+                                         });
+    if (nextIt == stepsByEnd.begin())
+    {
+      break;
+    }
+    criticalPath.push_back(*(nextIt - 1));
+  }
+
+  std::reverse(criticalPath.begin(), criticalPath.end());
+  return criticalPath;
+}
+
+} // namespace
+
+
+// Aggregates the records written by frut-tools build-telemetry into a report, then moves
+// them to <records-file>.previous, so that the next report only covers the next builds
+int buildReportMain(int argc, char* argv[])
+{
+  if (argc != 3 && argc != 4)
+  {
+    std::cerr << "usage: frut-tools build-report"
+              << " <records-file>"
+              << " <report-file>"
+              << " [<ranked-steps-count>]" << std::endl;
+    return 1;
+  }
+
+  const std::string recordsFile{argv[1]};
+  const std::string reportFile{argv[2]};
+  auto rankedStepsCount = std::vector<Step>::size_type{20};
+  if (argc == 4)
+  {
+    rankedStepsCount = static_cast<std::vector<Step>::size_type>(std::stoul(argv[3]));
+  }
+
+  std::vector<Step> steps;
+  {
+    std::ifstream recordsStream{recordsFile};
+    std::string line;
+    while (std::getline(recordsStream, line))
+    {
+      Step step;
+      if (parseRecord(line, step))
+      {
+        steps.push_back(step);
+      }
+    }
+  }
+
+  std::ofstream report{reportFile};
+  if (!report)
+  {
+    std::cerr << "Failed to write " << reportFile << std::endl;
+    return 1;
+  }
+
+  if (steps.empty())
+  {
+    report << "No build steps were recorded since the previous report.\n";
+    std::cout << "No build steps were recorded since the previous report" << std::endl;
+    return 0;
+  }
+
+  auto buildStart = steps.front().start;
+  auto buildEnd = steps.front().end;
+  auto totalDuration = 0ll;
+  auto failedStepsCount = 0;
+  std::map<std::string, std::pair<long long, int>> durationAndCountByCategory;
+  for (const auto& step : steps)
+  {
+    buildStart = std::min(buildStart, step.start);
+    buildEnd = std::max(buildEnd, step.end);
+    totalDuration += step.getDuration();
+    if (step.exitCode != 0)
+    {
+      ++failedStepsCount;
+    }
+    auto& durationAndCount = durationAndCountByCategory[getCategory(step)];
+    durationAndCount.first += step.getDuration();
+    ++durationAndCount.second;
+  }
+  const auto buildSpan = std::max(buildEnd - buildStart, 1ll);
+
+  report << "Build report of the steps recorded since the previous report\n"
+         << "\n"
+         << "Steps: " << steps.size() << " (" << failedStepsCount << " failed)\n"
+         << "Wall time: " << formatSeconds(buildSpan) << " s\n"
+         << "Total step time: " << formatSeconds(totalDuration) << " s\n"
+         << "Average parallelism: " << std::fixed << std::setprecision(2)
+         << static_cast<double>(totalDuration) / buildSpan << "\n";
+
+  std::vector<std::pair<long long, std::string>> categories;
+  for (const auto& category : durationAndCountByCategory)
+  {
+    categories.emplace_back(category.second.first, category.first);
+  }
+  std::sort(categories.rbegin(), categories.rend());
+
+  report << "\n"
+         << "Time by category:\n"
+         << "     time (s)  steps   share  category\n";
+  for (const auto& category : categories)
+  {
+    const auto share = 100.0 * category.first / std::max(totalDuration, 1ll);
+    report << std::setw(13) << formatSeconds(category.first) << std::setw(7)
+           << durationAndCountByCategory[category.second].second << std::setw(7)
+           << std::fixed << std::setprecision(1) << share << "%  " << category.second
+           << "\n";
+  }
+
+  const auto criticalPath = getCriticalPath(steps);
+  auto criticalPathDuration = 0ll;
+  for (const auto step : criticalPath)
+  {
+    criticalPathDuration += step->getDuration();
+  }
+
+  report << "\n"
+         << "Critical path (estimated): " << formatSeconds(criticalPathDuration)
+         << " s of steps and " << formatSeconds(buildSpan - criticalPathDuration)
+         << " s between them\n"
+         << "    start (s)  time (s)  kind      target: step\n";
+  for (const auto step : criticalPath)
+  {
+    report << std::setw(13) << formatSeconds(step->start - buildStart) << std::setw(10)
+           << formatSeconds(step->getDuration()) << "  " << std::left << std::setw(8)
+           << step->kind << std::right << "  " << step->targetName << ": " << step->name
+           << "\n";
+  }
+
+  std::vector<const Step*> translationUnits;
+  for (const auto& step : steps)
+  {
+    if (step.kind == "compile")
+    {
+      translationUnits.push_back(&step);
+    }
+  }
+  std::sort(translationUnits.begin(), translationUnits.end(),
+            [](const Step* lhs, const Step* rhs) {
+              return lhs->getDuration() > rhs->getDuration();
+            });
+  if (translationUnits.size() > rankedStepsCount)
+  {
+    translationUnits.resize(rankedStepsCount);
+  }
+
+  report << "\n"
+         << "Slowest translation units:\n"
+         << "     time (s)  peak RSS (MiB)  category      target: source file\n";
+  for (const auto step : translationUnits)
+  {
+    report << std::setw(13) << formatSeconds(step->getDuration()) << std::setw(16)
+           << formatMiB(step->peakRssInKiB) << "  " << std::left << std::setw(12)
+           << getCategory(*step) << std::right << "  " << step->targetName << ": "
+           << step->name << "\n";
+  }
+
+  report.close();
+  std::cout << "Critical path: " << formatSeconds(criticalPathDuration) << " s over "
+            << criticalPath.size() << " steps, see " << reportFile << std::endl;
+
+  const auto previousRecordsFile = recordsFile + ".previous";
+  std::remove(previousRecordsFile.c_str());
+  if (std::rename(recordsFile.c_str(), previousRecordsFile.c_str()) != 0)
+  {
+    std::cerr << "Failed to move " << recordsFile << " to " << previousRecordsFile
+              << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
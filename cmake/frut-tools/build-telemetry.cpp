@@ -0,0 +1,200 @@
+// Copyright (c) 2018 Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+
+long long getMicrosecondsSinceEpoch()
+{
+  using namespace std::chrono;
+  return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+
+std::string joinWithSpaces(const std::vector<std::string>& strings)
+{
+  std::string joined;
+  for (const auto& string : strings)
+  {
+    if (!joined.empty())
+    {
+      joined += ' ';
+    }
+    joined += string;
+  }
+
+  // The records are tab-separated lines
+  for (auto& character : joined)
+  {
+    if (character == '\t' || character == '\n' || character == '\r')
+    {
+      character = ' ';
+    }
+  }
+
+  return joined;
+}
+
+} // namespace
+
+
+// Runs a compile, link or custom command on behalf of the build system (it is installed
+// as RULE_LAUNCH_COMPILE, RULE_LAUNCH_LINK and RULE_LAUNCH_CUSTOM), and appends a record
+// of its start, end, peak resident set size and exit code to the records file
+int buildTelemetryMain(int argc, char* argv[])
+{
+  std::vector<std::string> args{argv, argv + argc};
+
+  auto separatorIt = args.end();
+  if (args.size() > 4)
+  {
+    separatorIt = std::find(args.begin() + 4, args.end(), "--");
+  }
+  if (separatorIt == args.end() || separatorIt + 1 == args.end())
+  {
+    std::cerr << "usage: frut-tools build-telemetry"
+              << " <records-file>"
+              << " <compile|link|custom>"
+              << " <target-name>"
+              << " [<step-name>...]"
+              << " -- <command> <args>..." << std::endl;
+    return 1;
+  }
+
+  const auto& recordsFile = args.at(1);
+  const auto& kind = args.at(2);
+  const auto& targetName = args.at(3);
+  const std::vector<std::string> command{separatorIt + 1, args.end()};
+
+  // Custom commands run when building a target (e.g. POST_BUILD) don't have an output,
+  // so they are named after their command line
+  auto stepName = joinWithSpaces({args.begin() + 4, separatorIt});
+  if (stepName.empty())
+  {
+    stepName = joinWithSpaces(command);
+    const auto maxLength = std::string::size_type{120};
+    if (stepName.size() > maxLength)
+    {
+      stepName = stepName.substr(0, maxLength - 3) + "...";
+    }
+  }
+
+#if defined(_WIN32)
+  std::cerr << "frut-tools build-telemetry is not supported on Windows" << std::endl;
+  return 1;
+#else
+  std::vector<char*> commandArgv;
+  for (const auto& arg : command)
+  {
+    commandArgv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  commandArgv.push_back(nullptr);
+
+  // The frut_build_report target is in the same directory as the project, but its own
+  // record would be the first one of the next report
+  if (command.size() > 2 && command.at(1) == "build-report" && command.at(2) == recordsFile)
+  {
+    execvp(commandArgv.front(), commandArgv.data());
+    std::perror(("frut-tools build-telemetry: " + command.front()).c_str());
+    return 127;
+  }
+
+  const auto start = getMicrosecondsSinceEpoch();
+
+  const auto pid = fork();
+  if (pid == -1)
+  {
+    std::perror("frut-tools build-telemetry: fork");
+    return 1;
+  }
+  if (pid == 0)
+  {
+    execvp(commandArgv.front(), commandArgv.data());
+    std::perror(("frut-tools build-telemetry: " + command.front()).c_str());
+    _exit(127);
+  }
+
+  // The resource usage of the command includes the one of the processes it waited for
+  // (e.g. cc1plus for the compiler driver)
+  auto status = 0;
+  struct rusage usage;
+  while (wait4(pid, &status, 0, &usage) == -1)
+  {
+    if (errno != EINTR)
+    {
+      std::perror("frut-tools build-telemetry: wait4");
+      return 1;
+    }
+  }
+
+  const auto end = getMicrosecondsSinceEpoch();
+
+  auto exitCode = 1;
+  if (WIFEXITED(status))
+  {
+    exitCode = WEXITSTATUS(status);
+  }
+  else if (WIFSIGNALED(status))
+  {
+    exitCode = 128 + WTERMSIG(status);
+  }
+
+#if defined(__APPLE__)
+  const auto peakRssInKiB = static_cast<long long>(usage.ru_maxrss) / 1024;
+#else
+  const auto peakRssInKiB = static_cast<long long>(usage.ru_maxrss);
+#endif
+
+  std::ostringstream record;
+  record << kind << '\t' << targetName << '\t' << stepName << '\t' << start << '\t' << end
+         << '\t' << peakRssInKiB << '\t' << exitCode << '\n';
+  const auto recordString = record.str();
+
+  // Several commands run in parallel, so each record is appended with a single write
+  const auto fd = open(recordsFile.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (fd == -1
+      || write(fd, recordString.data(), recordString.size())
+           != static_cast<ssize_t>(recordString.size()))
+  {
+    std::perror(("frut-tools build-telemetry: " + recordsFile).c_str());
+  }
+  if (fd != -1)
+  {
+    close(fd);
+  }
+
+  return exitCode;
+#endif
+}
@@ -0,0 +1,602 @@
+// Copyright (c) 2018 Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+
+// Only what is needed to read the traces written by clang -ftime-trace
+struct JsonValue
+{
+  enum class Type
+  {
+    Null,
+    Boolean,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+  Type type = Type::Null;
+  double number = 0.0;
+  std::string string;
+  std::vector<JsonValue> array;
+  std::vector<std::pair<std::string, JsonValue>> object;
+
+  const JsonValue* getProperty(const std::string& name) const
+  {
+    for (const auto& property : object)
+    {
+      if (property.first == name)
+      {
+        return &property.second;
+      }
+    }
+    return nullptr;
+  }
+};
+
+
+class JsonParser
+{
+public:
+  explicit JsonParser(const std::string& text)
+    : mText(text)
+  {
+  }
+
+  bool parse(JsonValue& value)
+  {
+    return parseValue(value) && (skipWhitespace(), mPos == mText.size());
+  }
+
+private:
+  void skipWhitespace()
+  {
+    while (mPos < mText.size() && std::isspace(static_cast<unsigned char>(mText[mPos])))
+    {
+      ++mPos;
+    }
+  }
+
+  bool consume(char expected)
+  {
+    skipWhitespace();
+    if (mPos < mText.size() && mText[mPos] == expected)
+    {
+      ++mPos;
+      return true;
+    }
+    return false;
+  }
+
+  bool parseValue(JsonValue& value)
+  {
+    skipWhitespace();
+    if (mPos >= mText.size())
+    {
+      return false;
+    }
+
+    const auto character = mText[mPos];
+    if (character == '{')
+    {
+      return parseObject(value);
+    }
+    if (character == '[')
+    {
+      return parseArray(value);
+    }
+    if (character == '"')
+    {
+      value.type = JsonValue::Type::String;
+      return parseString(value.string);
+    }
+    if (mText.compare(mPos, 4, "true") == 0 || mText.compare(mPos, 5, "false") == 0)
+    {
+      value.type = JsonValue::Type::Boolean;
+      mPos += character == 't' ? 4 : 5;
+      return true;
+    }
+    if (mText.compare(mPos, 4, "null") == 0)
+    {
+      mPos += 4;
+      return true;
+    }
+
+    const auto begin = mText.c_str() + mPos;
+    char* end = nullptr;
+    value.type = JsonValue::Type::Number;
+    value.number = std::strtod(begin, &end);
+    mPos += static_cast<std::string::size_type>(end - begin);
+    return end != begin;
+  }
+
+  bool parseObject(JsonValue& value)
+  {
+    value.type = JsonValue::Type::Object;
+    ++mPos;
+    if (consume('}'))
+    {
+      return true;
+    }
+    do
+    {
+      std::string name;
+      skipWhitespace();
+      if (!parseString(name) || !consume(':'))
+      {
+        return false;
+      }
+      value.object.emplace_back(std::move(name), JsonValue{});
+      if (!parseValue(value.object.back().second))
+      {
+        return false;
+      }
+    } while (consume(','));
+    return consume('}');
+  }
+
+  bool parseArray(JsonValue& value)
+  {
+    value.type = JsonValue::Type::Array;
+    ++mPos;
+    if (consume(']'))
+    {
+      return true;
+    }
+    do
+    {
+      value.array.emplace_back();
+      if (!parseValue(value.array.back()))
+      {
+        return false;
+      }
+    } while (consume(','));
+    return consume(']');
+  }
+
+  bool parseString(std::string& string)
+  {
+    if (mPos >= mText.size() || mText[mPos] != '"')
+    {
+      return false;
+    }
+    ++mPos;
+    while (mPos < mText.size() && mText[mPos] != '"')
+    {
+      auto character = mText[mPos++];
+      if (character == '\\' && mPos < mText.size())
+      {
+        character = mText[mPos++];
+        switch (character)
+        {
+        case 'b':
+          character = '\b';
+          break;
+        case 'f':
+          character = '\f';
+          break;
+        case 'n':
+          character = '\n';
+          break;
+        case 'r':
+          character = '\r';
+          break;
+        case 't':
+          character = '\t';
+          break;
+        case 'u':
+          // The paths and the names of the events are ASCII, so the other characters
+          // are replaced
+          mPos += 4;
+          character = '?';
+          break;
+        default:
+          break;
+        }
+      }
+      string += character;
+    }
+    return mPos++ < mText.size();
+  }
+
+  const std::string& mText;
+  std::string::size_type mPos = 0;
+};
+
+
+struct CompileTimes
+{
+  long long frontend = 0;
+  long long templates = 0;
+  long long backend = 0;
+  int translationUnitsCount = 0;
+
+  long long getTotal() const
+  {
+    return frontend + templates + backend;
+  }
+};
+
+
+struct HeaderTime
+{
+  long long total = 0;
+  int translationUnitsCount = 0;
+};
+
+
+bool readFile(const std::string& path, std::string& content)
+{
+  std::ifstream stream{path, std::ios::binary};
+  if (!stream)
+  {
+    return false;
+  }
+  std::ostringstream contentStream;
+  contentStream << stream.rdbuf();
+  content = contentStream.str();
+  return true;
+}
+
+
+long long getNumber(const JsonValue& event, const std::string& name)
+{
+  const auto value = event.getProperty(name);
+  return value && value->type == JsonValue::Type::Number
+           ? static_cast<long long>(value->number)
+           : 0;
+}
+
+
+std::string getString(const JsonValue& event, const std::string& name)
+{
+  const auto value = event.getProperty(name);
+  return value && value->type == JsonValue::Type::String ? value->string : std::string{};
+}
+
+
+// Reads the "Total" events of a trace written by clang -ftime-trace, and adds the time
+// spent in each header included through JuceHeader.h to headerTimes
+bool readClangTrace(const std::string& path,
+                    CompileTimes& times,
+                    std::map<std::string, HeaderTime>& headerTimes)
+{
+  std::string content;
+  JsonValue trace;
+  if (!readFile(path, content) || !JsonParser{content}.parse(trace))
+  {
+    std::cerr << "Failed to read " << path << std::endl;
+    return false;
+  }
+  const auto events = trace.getProperty("traceEvents");
+  if (!events || events->type != JsonValue::Type::Array)
+  {
+    std::cerr << "No traceEvents in " << path << std::endl;
+    return false;
+  }
+
+  auto totalFrontend = 0ll;
+  auto totalTemplates = 0ll;
+  auto juceHeaderStart = -1ll;
+  auto juceHeaderEnd = -1ll;
+  std::vector<const JsonValue*> sourceEvents;
+  for (const auto& event : events->array)
+  {
+    const auto name = getString(event, "name");
+    if (name == "Total Frontend")
+    {
+      totalFrontend = getNumber(event, "dur");
+    }
+    else if (name == "Total Backend")
+    {
+      times.backend += getNumber(event, "dur");
+    }
+    else if (name == "Total InstantiateClass" || name == "Total InstantiateFunction")
+    {
+      totalTemplates += getNumber(event, "dur");
+    }
+    else if (name == "Source" && getString(event, "ph") == "X")
+    {
+      const auto args = event.getProperty("args");
+      const auto header = args ? getString(*args, "detail") : std::string{};
+      const auto slashPos = header.find_last_of("/\\");
+      if (header.substr(slashPos == std::string::npos ? 0 : slashPos + 1)
+          == "JuceHeader.h")
+      {
+        juceHeaderStart = getNumber(event, "ts");
+        juceHeaderEnd = juceHeaderStart + getNumber(event, "dur");
+      }
+      else
+      {
+        sourceEvents.push_back(&event);
+      }
+    }
+  }
+
+  // The template instantiations are part of the frontend
+  totalTemplates = std::min(totalTemplates, totalFrontend);
+  times.frontend += totalFrontend - totalTemplates;
+  times.templates += totalTemplates;
+
+  // A header without include guards can be parsed several times by the same translation
+  // unit, but the translation unit is only counted once
+  std::set<std::string> parsedHeaders;
+  for (const auto event : sourceEvents)
+  {
+    const auto start = getNumber(*event, "ts");
+    const auto duration = getNumber(*event, "dur");
+    if (juceHeaderStart < 0 || start < juceHeaderStart
+        || start + duration > juceHeaderEnd)
+    {
+      continue;
+    }
+    // The time of a header includes the time of the headers it includes
+    const auto header = getString(*event->getProperty("args"), "detail");
+    auto& headerTime = headerTimes[header];
+    headerTime.total += duration;
+    if (parsedHeaders.insert(header).second)
+    {
+      ++headerTime.translationUnitsCount;
+    }
+  }
+
+  return true;
+}
+
+
+// Reads the phases of the report printed by gcc -ftime-report
+bool readGccReport(const std::string& path, CompileTimes& times)
+{
+  std::ifstream stream{path};
+  if (!stream)
+  {
+    std::cerr << "Failed to read " << path << std::endl;
+    return false;
+  }
+
+  auto frontend = 0ll;
+  auto templates = 0ll;
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    const auto colonPos = line.find(':');
+    if (colonPos == std::string::npos)
+    {
+      continue;
+    }
+    auto name = line.substr(0, colonPos);
+    name.erase(0, name.find_first_not_of(" |"));
+    name.erase(name.find_last_not_of(' ') + 1);
+
+    // <usr> (<percent>%) <sys> (<percent>%) <wall> (<percent>%) <GGC> (<percent>%)
+    auto values = line.substr(colonPos + 1);
+    std::replace_if(values.begin(), values.end(),
+                    [](char character) {
+                      return character == '(' || character == ')' || character == '%';
+                    },
+                    ' ');
+    std::istringstream valuesStream{values};
+    double usr, usrPercent, sys, sysPercent, wall;
+    if (!(valuesStream >> usr >> usrPercent >> sys >> sysPercent >> wall))
+    {
+      continue;
+    }
+    const auto microseconds = static_cast<long long>(wall * 1000000);
+
+    if (name == "phase setup" || name == "phase parsing"
+        || name == "phase lang. deferred")
+    {
+      frontend += microseconds;
+    }
+    else if (name == "phase opt and generate" || name == "phase last asm")
+    {
+      times.backend += microseconds;
+    }
+    else if (name == "template instantiation")
+    {
+      templates += microseconds;
+    }
+  }
+
+  templates = std::min(templates, frontend);
+  times.frontend += frontend - templates;
+  times.templates += templates;
+  return true;
+}
+
+
+std::string formatSeconds(long long microseconds)
+{
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(3) << microseconds / 1000000.0;
+  return stream.str();
+}
+
+} // namespace
+
+
+// Aggregates the traces written when compiling with FRUT_COMPILE_TIME_REPORT into a
+// report ranking the JUCE modules, the source groups and the headers included through
+// JuceHeader.h by compile time
+int compileTimeReportMain(int argc, char* argv[])
+{
+  if (argc != 4 && argc != 5)
+  {
+    std::cerr << "usage: frut-tools compile-time-report"
+              << " <translation-units-file>"
+              << " <traces-dir>"
+              << " <report-file>"
+              << " [<ranked-headers-count>]" << std::endl;
+    return 1;
+  }
+
+  const std::string translationUnitsFile{argv[1]};
+  const std::string tracesDir{argv[2]};
+  const std::string reportFile{argv[3]};
+  auto rankedHeadersCount = std::vector<HeaderTime>::size_type{20};
+  if (argc == 5)
+  {
+    rankedHeadersCount =
+      static_cast<std::vector<HeaderTime>::size_type>(std::stoul(argv[4]));
+  }
+
+  std::ifstream translationUnitsStream{translationUnitsFile};
+  if (!translationUnitsStream)
+  {
+    std::cerr << "Failed to read " << translationUnitsFile << std::endl;
+    return 1;
+  }
+
+  // Each line is <kind>\t<name>\t<source-file-identifier>\t<source-file>
+  std::map<std::pair<std::string, std::string>, CompileTimes> timesByCategory;
+  std::map<std::string, HeaderTime> headerTimes;
+  auto tracedCount = 0;
+  auto untracedCount = 0;
+  auto hasClangTraces = false;
+  std::string line;
+  while (std::getline(translationUnitsStream, line))
+  {
+    std::vector<std::string> fields;
+    std::istringstream lineStream{line};
+    std::string field;
+    while (std::getline(lineStream, field, '\t'))
+    {
+      fields.push_back(field);
+    }
+    if (fields.size() != 4)
+    {
+      continue;
+    }
+
+    CompileTimes times;
+    const auto tracePath = tracesDir + "/" + fields.at(2);
+    if (std::ifstream{tracePath + ".json"})
+    {
+      if (!readClangTrace(tracePath + ".json", times, headerTimes))
+      {
+        return 1;
+      }
+      hasClangTraces = true;
+    }
+    else if (std::ifstream{tracePath + ".txt"})
+    {
+      if (!readGccReport(tracePath + ".txt", times))
+      {
+        return 1;
+      }
+    }
+    else
+    {
+      // Not compiled yet, or restored from a compiler cache
+      ++untracedCount;
+      continue;
+    }
+    ++tracedCount;
+
+    auto& categoryTimes = timesByCategory[std::make_pair(fields.at(0), fields.at(1))];
+    categoryTimes.frontend += times.frontend;
+    categoryTimes.templates += times.templates;
+    categoryTimes.backend += times.backend;
+    ++categoryTimes.translationUnitsCount;
+  }
+
+  std::ofstream report{reportFile};
+  if (!report)
+  {
+    std::cerr << "Failed to write " << reportFile << std::endl;
+    return 1;
+  }
+
+  std::vector<std::pair<long long, std::pair<std::string, std::string>>> categories;
+  for (const auto& category : timesByCategory)
+  {
+    categories.emplace_back(category.second.getTotal(), category.first);
+  }
+  std::sort(categories.rbegin(), categories.rend());
+
+  report << "Compile time report of " << tracedCount << " translation units";
+  if (untracedCount > 0)
+  {
+    report << " (" << untracedCount << " others have no trace, they were not compiled "
+           << "with the time traces enabled)";
+  }
+  report << "\n"
+         << "\n"
+         << "Time by JUCE module and source group:\n"
+         << "    total (s)  frontend (s)  templates (s)  backend (s)    TUs  kind"
+         << "    name\n";
+  for (const auto& category : categories)
+  {
+    const auto& times = timesByCategory[category.second];
+    report << std::setw(13) << formatSeconds(times.getTotal()) << std::setw(14)
+           << formatSeconds(times.frontend) << std::setw(15)
+           << formatSeconds(times.templates) << std::setw(13)
+           << formatSeconds(times.backend) << std::setw(7) << times.translationUnitsCount
+           << "  " << std::left << std::setw(6) << category.second.first << std::right
+           << "  " << category.second.second << "\n";
+  }
+
+  report << "\n"
+         << "Most expensive headers included through JuceHeader.h:\n";
+  if (!hasClangTraces)
+  {
+    report << "  Only available with Clang, since GCC doesn't report the time spent in "
+           << "each header.\n";
+  }
+  else
+  {
+    std::vector<std::pair<long long, std::string>> headers;
+    for (const auto& header : headerTimes)
+    {
+      headers.emplace_back(header.second.total, header.first);
+    }
+    std::sort(headers.rbegin(), headers.rend());
+    if (headers.size() > rankedHeadersCount)
+    {
+      headers.resize(rankedHeadersCount);
+    }
+
+    report << "    total (s)    TUs  average (s)  header\n";
+    for (const auto& header : headers)
+    {
+      const auto& headerTime = headerTimes[header.second];
+      report << std::setw(13) << formatSeconds(headerTime.total) << std::setw(7)
+             << headerTime.translationUnitsCount << std::setw(13)
+             << formatSeconds(headerTime.total / headerTime.translationUnitsCount)
+             << "  " << header.second << "\n";
+    }
+  }
+
+  std::cout << "Compile time report written to " << reportFile << std::endl;
+  return 0;
+}
@@ -25,11 +25,11 @@
 #include <vector>
 
 
-int main(int argc, char* argv[])
+int iconMain(int argc, char* argv[])
 {
   if (argc < 5)
   {
-    std::cerr << "usage: IconBuilder"
+    std::cerr << "usage: frut-tools icon"
               << " <icon-format:icns,ico>"
               << " <icon-file-output-dir>"
               << " <small-icon-image-file>"
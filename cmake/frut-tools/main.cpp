@@ -0,0 +1,77 @@
+// Copyright (c) 2018 Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <string>
+
+
+int binaryDataMain(int argc, char* argv[]);
+int buildReportMain(int argc, char* argv[]);
+int buildTelemetryMain(int argc, char* argv[]);
+int compileTimeReportMain(int argc, char* argv[]);
+int iconMain(int argc, char* argv[]);
+int plistMergeMain(int argc, char* argv[]);
+
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "usage: frut-tools"
+              << " <command:binarydata,build-report,build-telemetry,compile-time-report,"
+              << "icon,plist-merge>"
+              << " <args>..." << std::endl;
+    return 1;
+  }
+
+  const std::string command{argv[1]};
+
+  // Each command sees its own name as argv[0]
+  if (command == "binarydata")
+  {
+    return binaryDataMain(argc - 1, argv + 1);
+  }
+
+  if (command == "build-report")
+  {
+    return buildReportMain(argc - 1, argv + 1);
+  }
+
+  if (command == "build-telemetry")
+  {
+    return buildTelemetryMain(argc - 1, argv + 1);
+  }
+
+  if (command == "compile-time-report")
+  {
+    return compileTimeReportMain(argc - 1, argv + 1);
+  }
+
+  if (command == "icon")
+  {
+    return iconMain(argc - 1, argv + 1);
+  }
+
+  if (command == "plist-merge")
+  {
+    return plistMergeMain(argc - 1, argv + 1);
+  }
+
+  std::cerr << "Unsupported command \"" << command << "\"" << std::endl;
+  return 1;
+}
+
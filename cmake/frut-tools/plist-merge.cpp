@@ -23,11 +23,11 @@
 #include <vector>
 
 
-int main(int argc, char* argv[])
+int plistMergeMain(int argc, char* argv[])
 {
   if (argc != 3)
   {
-    std::cerr << "usage: PListMerger"
+    std::cerr << "usage: frut-tools plist-merge"
               << " <first-plist-content>"
               << " <second-plist-content>" << std::endl;
     return 1;
@@ -0,0 +1,108 @@
+/*
+
+    The source files listed in MULTI_ISA_SOURCES are compiled once per instruction set
+    level, and must put their functions in the FRUT_ISA_NAMESPACE namespace. The other
+    source files declare these functions with FRUT_ISA_DECLARE, and call them with
+    FRUT_ISA_DISPATCH, which picks the best implementation for the CPU.
+
+        FRUT_ISA_DECLARE (void applyGain (float* samples, int numSamples, float gain));
+
+        FRUT_ISA_DISPATCH (applyGain) (buffer, numSamples, 0.5f);
+
+    The source files listed in MULTI_ISA_SOURCES must not define inline or template
+    functions outside of FRUT_ISA_NAMESPACE (e.g. by using std::vector), since the linker
+    could keep their copy compiled for a newer CPU. The build fails if they do.
+
+*/
+
+#pragma once
+
+#ifndef FRUT_ISA_NAMESPACE
+ #define FRUT_ISA_NAMESPACE frut_isa_baseline
+#endif
+
+#define FRUT_ISA_DECLARE(declaration) \
+  @isa_declare_code@
+
+#if (defined (__GNUC__) || defined (__clang__)) \
+  && (defined (__x86_64__) || defined (__i386__))
+ #define FRUT_ISA_HAS_CPU_BUILTINS 1
+ #include <cpuid.h>
+#endif
+
+namespace frut
+{
+namespace isa
+{
+// Each translation unit has its own copy of getLevel(), so that it is never the copy of a
+// source file compiled for a newer CPU
+namespace
+{
+    inline int getLevel() noexcept
+    {
+        static const int cpuLevel = []
+        {
+            int level = 1;
+           #ifdef FRUT_ISA_HAS_CPU_BUILTINS
+            __builtin_cpu_init();
+           #if defined (__clang__) || __GNUC__ < 12
+            // __builtin_cpu_supports doesn't know these features, which don't need the
+            // support of the operating system
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            __get_cpuid (1, &eax, &ebx, &ecx, &edx);
+            const bool hasCmpxchg16b = (ecx & (1u << 13)) != 0;
+            const bool hasMovbe = (ecx & (1u << 22)) != 0;
+            const bool hasF16c = (ecx & (1u << 29)) != 0;
+            eax = ebx = ecx = edx = 0;
+            __get_cpuid (0x80000001, &eax, &ebx, &ecx, &edx);
+            const bool hasLahfSahf = (ecx & (1u << 0)) != 0;
+            const bool hasLzcnt = (ecx & (1u << 5)) != 0;
+
+            if (hasCmpxchg16b && hasLahfSahf
+                && __builtin_cpu_supports ("popcnt")
+                && __builtin_cpu_supports ("sse3")
+                && __builtin_cpu_supports ("sse4.1")
+                && __builtin_cpu_supports ("sse4.2")
+                && __builtin_cpu_supports ("ssse3"))
+            {
+                level = 2;
+
+                if (hasF16c && hasLzcnt && hasMovbe
+                    && __builtin_cpu_supports ("avx")
+                    && __builtin_cpu_supports ("avx2")
+                    && __builtin_cpu_supports ("bmi")
+                    && __builtin_cpu_supports ("bmi2")
+                    && __builtin_cpu_supports ("fma"))
+                {
+                    level = 3;
+
+                    if (__builtin_cpu_supports ("avx512f")
+                        && __builtin_cpu_supports ("avx512bw")
+                        && __builtin_cpu_supports ("avx512cd")
+                        && __builtin_cpu_supports ("avx512dq")
+                        && __builtin_cpu_supports ("avx512vl"))
+                        level = 4;
+                }
+            }
+           #else
+            if (__builtin_cpu_supports ("x86-64-v2"))
+                level = 2;
+
+            if (__builtin_cpu_supports ("x86-64-v3"))
+                level = 3;
+
+            if (__builtin_cpu_supports ("x86-64-v4"))
+                level = 4;
+           #endif
+           #endif
+            return level;
+        }();
+
+        return cpuLevel;
+    }
+}
+}
+}
+
+#define FRUT_ISA_DISPATCH(name) \
+  (@isa_dispatch_code@)
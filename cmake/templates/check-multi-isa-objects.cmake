@@ -0,0 +1,37 @@
+# The linker keeps only one definition of each inline or template function, so a weak
+# symbol of a MULTI_ISA_SOURCES object could be the copy compiled for a newer CPU
+string(REPLACE "|" ";" objects "${objects}")
+
+unset(shared_symbols)
+foreach(object IN LISTS objects)
+  execute_process(
+    COMMAND "${nm}" "--defined-only" "--demangle" "${object}"
+    OUTPUT_VARIABLE nm_output
+    RESULT_VARIABLE nm_return_code
+  )
+  if(NOT nm_return_code EQUAL 0)
+    message(FATAL_ERROR "Could not list the symbols of ${object}")
+  endif()
+
+  string(REPLACE ";" "\\;" nm_output "${nm_output}")
+  string(REPLACE "\n" ";" nm_lines "${nm_output}")
+  foreach(line IN LISTS nm_lines)
+    if(line MATCHES "^[0-9a-fA-F]* [uVvWw] (.*)$")
+      set(symbol "${CMAKE_MATCH_1}")
+      if(NOT symbol MATCHES "${isa_namespace}::"
+          AND NOT symbol MATCHES "^(DW\\.ref\\..*|__clang_call_terminate)$")
+        list(APPEND shared_symbols "  ${symbol}")
+      endif()
+    endif()
+  endforeach()
+endforeach()
+
+if(shared_symbols)
+  list(REMOVE_DUPLICATES shared_symbols)
+  string(REPLACE ";" "\n" shared_symbols "${shared_symbols}")
+  message(FATAL_ERROR "The MULTI_ISA_SOURCES compiled in ${isa_namespace} define inline"
+    " or template functions outside of ${isa_namespace}, so the whole binary could use"
+    " their copy compiled for a newer CPU:\n${shared_symbols}\nMove these functions"
+    " into FRUT_ISA_NAMESPACE, or their uses out of the MULTI_ISA_SOURCES."
+  )
+endif()
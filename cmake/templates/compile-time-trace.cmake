@@ -0,0 +1,50 @@
+# Compiler launcher: runs the compiler command given after "--" with -ftime-trace (Clang)
+# or -ftime-report (GCC), and saves the trace or the report to
+# <traces_dir>/<source_file_identifier>.json or .txt
+
+include("${CMAKE_CURRENT_LIST_DIR}/compiler-launcher-arguments.cmake")
+
+get_filename_component(source_file "${source_file}" ABSOLUTE)
+get_filename_component(object_file "${object_file}" ABSOLUTE)
+string(MAKE_C_IDENTIFIER "${source_file}" source_file_identifier)
+
+if(compiler_id MATCHES "Clang")
+  # Clang writes the trace next to the object file
+  execute_process(
+    COMMAND ${compiler_command} "-ftime-trace"
+    RESULT_VARIABLE compiler_return_code
+  )
+  if(NOT compiler_return_code EQUAL 0)
+    message(FATAL_ERROR "Error when compiling ${source_file}")
+  endif()
+  string(REGEX REPLACE "\\.[^./\\\\]*$" ".json" trace_file "${object_file}")
+  if(EXISTS "${trace_file}")
+    file(RENAME "${trace_file}" "${traces_dir}/${source_file_identifier}.json")
+  endif()
+elseif(compiler_id STREQUAL "GNU")
+  # GCC prints the report to stderr, after the diagnostics
+  execute_process(
+    COMMAND ${compiler_command} "-ftime-report"
+    ERROR_VARIABLE compiler_stderr
+    RESULT_VARIABLE compiler_return_code
+  )
+  string(FIND "${compiler_stderr}" "\nTime variable" report_pos)
+  if(report_pos EQUAL -1 AND compiler_stderr MATCHES "^Time variable")
+    set(report_pos 0)
+  endif()
+  if(report_pos EQUAL -1)
+    set(diagnostics "${compiler_stderr}")
+  else()
+    string(SUBSTRING "${compiler_stderr}" 0 ${report_pos} diagnostics)
+    string(SUBSTRING "${compiler_stderr}" ${report_pos} -1 report)
+    file(WRITE "${traces_dir}/${source_file_identifier}.txt" "${report}")
+  endif()
+  if(NOT diagnostics STREQUAL "")
+    message("${diagnostics}")
+  endif()
+  if(NOT compiler_return_code EQUAL 0)
+    message(FATAL_ERROR "Error when compiling ${source_file}")
+  endif()
+else()
+  message(FATAL_ERROR "Compile time traces are only supported with GCC and Clang")
+endif()
@@ -0,0 +1,29 @@
+# Included by the compiler launchers: reads the compiler command given after "--" into
+# compiler_command, and its source file (after "-c") and object file (after "-o") into
+# source_file and object_file
+
+unset(compiler_command)
+unset(source_file)
+unset(object_file)
+set(in_compiler_command FALSE)
+set(next_arg "")
+math(EXPR last_arg_index "${CMAKE_ARGC} - 1")
+foreach(arg_index RANGE ${last_arg_index})
+  set(arg "${CMAKE_ARGV${arg_index}}")
+  if(in_compiler_command)
+    list(APPEND compiler_command "${arg}")
+    if(next_arg STREQUAL "source")
+      set(source_file "${arg}")
+    elseif(next_arg STREQUAL "object")
+      set(object_file "${arg}")
+    endif()
+    set(next_arg "")
+    if(arg STREQUAL "-c")
+      set(next_arg "source")
+    elseif(arg STREQUAL "-o")
+      set(next_arg "object")
+    endif()
+  elseif(arg STREQUAL "--")
+    set(in_compiler_command TRUE)
+  endif()
+endforeach()
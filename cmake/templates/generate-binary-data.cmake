@@ -0,0 +1,47 @@
+# Runs the "frut-tools binarydata" command given after "--", then writes empty
+# BinaryData<N>.cpp files up to <cpp_files_count>, so that all the outputs declared when
+# configuring exist and none of them is left over from a previous build
+
+unset(binarydata_command)
+set(in_binarydata_command FALSE)
+math(EXPR last_arg_index "${CMAKE_ARGC} - 1")
+foreach(arg_index RANGE ${last_arg_index})
+  set(arg "${CMAKE_ARGV${arg_index}}")
+  if(in_binarydata_command)
+    list(APPEND binarydata_command "${arg}")
+  elseif(arg STREQUAL "--")
+    set(in_binarydata_command TRUE)
+  endif()
+endforeach()
+
+execute_process(
+  COMMAND ${binarydata_command}
+  OUTPUT_VARIABLE binary_data_filenames
+  RESULT_VARIABLE binarydata_return_code
+)
+if(NOT binarydata_return_code EQUAL 0)
+  message(FATAL_ERROR "Error when executing frut-tools binarydata")
+endif()
+
+set(empty_cpp_content "// Not needed for the current resources\n")
+foreach(index RANGE 1 ${cpp_files_count})
+  if(index EQUAL 1)
+    set(filename "BinaryData.cpp")
+  else()
+    set(filename "BinaryData${index}.cpp")
+  endif()
+  # The output of frut-tools is a list of file names, each one followed by ";"
+  string(FIND ";${binary_data_filenames}" ";${filename};" filename_index)
+  if(filename_index EQUAL -1)
+    set(cpp_file "${binary_data_dir}/${filename}")
+    # Like frut-tools, only write the file when its content changes
+    if(EXISTS "${cpp_file}")
+      file(READ "${cpp_file}" cpp_content)
+    else()
+      set(cpp_content "")
+    endif()
+    if(NOT cpp_content STREQUAL empty_cpp_content)
+      file(WRITE "${cpp_file}" "${empty_cpp_content}")
+    endif()
+  endif()
+endforeach()
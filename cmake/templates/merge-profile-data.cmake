@@ -0,0 +1,8 @@
+file(GLOB raw_profiles "@raw_profile_dir@/*.profraw")
+execute_process(
+  COMMAND "@llvm_profdata_exe@" "merge" "-output=@profile_data_file@" ${raw_profiles}
+  RESULT_VARIABLE llvm_profdata_return_code
+)
+if(NOT llvm_profdata_return_code EQUAL 0)
+  message(FATAL_ERROR "Error when merging the profile data")
+endif()
@@ -0,0 +1,53 @@
+# The objects of the instrumented build don't always have the same relative path as the
+# objects of the project (e.g. for the source files outside of the project folder), so
+# the .gcda files are renamed after the objects of the project, in the same order
+file(STRINGS "@instrumented_objects_file@" instrumented_objects)
+file(STRINGS "@objects_file@" objects)
+list(LENGTH instrumented_objects instrumented_objects_count)
+list(LENGTH objects objects_count)
+if(NOT instrumented_objects_count EQUAL objects_count)
+  message(FATAL_ERROR "The objects of the instrumented build don't match the project")
+endif()
+
+function(get_profile_data_file_name object build_dir out_file_name)
+  # GCC names the .gcda file after the object, relative to -fprofile-prefix-path
+  file(RELATIVE_PATH file_name "${build_dir}" "${object}")
+  string(REGEX REPLACE "\\.[^./]*$" "" file_name "${file_name}")
+  string(REPLACE "/" "#" file_name "${file_name}")
+  set(${out_file_name} "${file_name}.gcda" PARENT_SCOPE)
+endfunction()
+
+set(renamed_dir "@profile_data_dir@/Renamed")
+file(MAKE_DIRECTORY "${renamed_dir}")
+unset(renamed_files)
+math(EXPR last_index "${objects_count} - 1")
+foreach(index RANGE ${last_index})
+  list(GET instrumented_objects ${index} instrumented_object)
+  list(GET objects ${index} object)
+  string(REGEX REPLACE "^([^|]*)\\|(.*)$" "\\1;\\2" instrumented_object
+    "${instrumented_object}"
+  )
+  string(REGEX REPLACE "^([^|]*)\\|(.*)$" "\\1;\\2" object "${object}")
+  list(GET instrumented_object 0 instrumented_target)
+  list(GET object 0 target)
+  if(NOT instrumented_target STREQUAL target)
+    message(FATAL_ERROR "The objects of the instrumented build don't match the project")
+  endif()
+  list(GET instrumented_object 1 instrumented_object)
+  list(GET object 1 object)
+  get_profile_data_file_name("${instrumented_object}" "@instrumented_build_dir@"
+    instrumented_file_name
+  )
+  get_profile_data_file_name("${object}" "@build_dir@" file_name)
+  # Files are moved out of the way first, in case a file is renamed after another one
+  if(EXISTS "@profile_data_dir@/${instrumented_file_name}")
+    file(RENAME "@profile_data_dir@/${instrumented_file_name}"
+      "${renamed_dir}/${file_name}"
+    )
+    list(APPEND renamed_files "${file_name}")
+  endif()
+endforeach()
+foreach(file_name ${renamed_files})
+  file(RENAME "${renamed_dir}/${file_name}" "@profile_data_dir@/${file_name}")
+endforeach()
+file(REMOVE_RECURSE "${renamed_dir}")
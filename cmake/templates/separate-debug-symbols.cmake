@@ -0,0 +1,51 @@
+# Moves the debug symbols of <binary_file> to .debug/.build-id/<xx>/<rest>.debug next to
+# it, and links them to the stripped binary through .debug/<binary_name>.debug
+
+if(NOT enabled)
+  return()
+endif()
+
+get_filename_component(binary_dir "${binary_file}" DIRECTORY)
+get_filename_component(binary_name "${binary_file}" NAME)
+set(build_id_note_file "${binary_dir}/.debug/${binary_name}.build-id")
+file(MAKE_DIRECTORY "${binary_dir}/.debug")
+
+execute_process(
+  COMMAND "${objcopy}" "--dump-section" ".note.gnu.build-id=${build_id_note_file}"
+  "${binary_file}"
+  RESULT_VARIABLE objcopy_return_code
+)
+if(NOT objcopy_return_code EQUAL 0)
+  message(FATAL_ERROR "Could not read the build-id of ${binary_file}")
+endif()
+
+# The note starts with namesz, descsz and type (4 bytes each) and the name "GNU\0"
+file(READ "${build_id_note_file}" build_id HEX OFFSET 16)
+file(REMOVE "${build_id_note_file}")
+string(SUBSTRING "${build_id}" 0 2 build_id_head)
+string(SUBSTRING "${build_id}" 2 -1 build_id_tail)
+
+# Same layout as /usr/lib/debug/.build-id/, so that the .debug directory can be used as
+# debug-file-directory by gdb, or uploaded as is to a symbol server
+set(debug_file "${binary_dir}/.debug/.build-id/${build_id_head}/${build_id_tail}.debug")
+get_filename_component(debug_file_dir "${debug_file}" DIRECTORY)
+file(MAKE_DIRECTORY "${debug_file_dir}")
+
+# The .gnu_debuglink section only stores the file name, which gdb looks up next to the
+# binary and in its .debug folder, so .debug/<binary_name>.debug links to the debug file
+set(debuglink_file "${binary_dir}/.debug/${binary_name}.debug")
+set(debuglink_target ".build-id/${build_id_head}/${build_id_tail}.debug")
+
+foreach(command
+    "${objcopy};--only-keep-debug;${binary_file};${debug_file}"
+    "${CMAKE_COMMAND};-E;create_symlink;${debuglink_target};${debuglink_file}"
+    "${objcopy};--strip-debug;--add-gnu-debuglink=${debuglink_file};${binary_file}"
+)
+  execute_process(
+    COMMAND ${command}
+    RESULT_VARIABLE command_return_code
+  )
+  if(NOT command_return_code EQUAL 0)
+    message(FATAL_ERROR "Error when separating the debug symbols of ${binary_file}")
+  endif()
+endforeach()
@@ -0,0 +1,30 @@
+# Compiler launcher: runs the compiler command given after "--" with the vectorisation
+# remarks enabled, and saves them to <remarks_dir>/<source_file_identifier>.txt
+
+include("${CMAKE_CURRENT_LIST_DIR}/compiler-launcher-arguments.cmake")
+
+# With LTO, the loops would only be vectorised (and reported) when linking
+if(compiler_id STREQUAL "GNU")
+  set(remarks_flags "-fno-lto" "-fopt-info-vec-all")
+elseif(compiler_id MATCHES "Clang")
+  set(remarks_flags "-fno-lto" "-Rpass=loop-vectorize" "-Rpass-missed=loop-vectorize")
+else()
+  message(FATAL_ERROR "Vectorisation remarks are only supported with GCC and Clang")
+endif()
+
+# The remarks are printed to stderr, so that they are replaced (and not appended to the
+# remarks of the previous build) when the source file is recompiled
+execute_process(
+  COMMAND ${compiler_command} ${remarks_flags}
+  ERROR_VARIABLE compiler_stderr
+  RESULT_VARIABLE compiler_return_code
+)
+if(NOT compiler_return_code EQUAL 0)
+  message("${compiler_stderr}")
+  message(FATAL_ERROR "Error when compiling ${source_file}")
+endif()
+
+get_filename_component(source_file "${source_file}" ABSOLUTE)
+file(RELATIVE_PATH source_file_identifier "${source_dir}" "${source_file}")
+string(MAKE_C_IDENTIFIER "${source_file_identifier}" source_file_identifier)
+file(WRITE "${remarks_dir}/${source_file_identifier}.txt" "${compiler_stderr}")
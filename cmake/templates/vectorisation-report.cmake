@@ -0,0 +1,115 @@
+# Collects the vectorisation remarks of the source files into a report listing, for each
+# file of the project, the vectorised and missed loops. When a baseline report is given,
+# fails if a file has fewer vectorised loops than in the baseline.
+
+set(source_files "@user_sources@")
+set(source_dir "@source_dir@")
+set(remarks_dir "@remarks_dir@")
+set(report_file "@report_file@")
+set(baseline_file "@JUCER_VECTORISATION_REPORT_BASELINE@")
+
+unset(report_files)
+foreach(source_file ${source_files})
+  file(RELATIVE_PATH source_file_identifier "${source_dir}" "${source_file}")
+  string(MAKE_C_IDENTIFIER "${source_file_identifier}" source_file_identifier)
+  set(remarks_file "${remarks_dir}/${source_file_identifier}.txt")
+  if(NOT EXISTS "${remarks_file}")
+    continue()
+  endif()
+
+  file(STRINGS "${remarks_file}" remarks REGEX ":[0-9]+:[0-9]+: (optimized|missed|remark): ")
+  foreach(remark ${remarks})
+    if(NOT remark MATCHES "^(.+):([0-9]+:[0-9]+): (optimized|missed|remark): (.*)$")
+      continue()
+    endif()
+    set(file "${CMAKE_MATCH_1}")
+    set(location "${CMAKE_MATCH_2}")
+    set(message "${CMAKE_MATCH_4}")
+
+    if(message MATCHES "^(loop vectorized|vectorized loop)")
+      set(kind "vectorised")
+    elseif(message MATCHES "^(couldn't vectorize loop|loop not vectorized)")
+      set(kind "missed")
+    else()
+      continue()
+    endif()
+
+    # Only report the loops of the project, not the ones inlined from JUCE or the system
+    get_filename_component(file "${file}" ABSOLUTE BASE_DIR "${source_dir}")
+    file(RELATIVE_PATH file "${source_dir}" "${file}")
+    if(file MATCHES "^\\.\\./")
+      continue()
+    endif()
+
+    string(MAKE_C_IDENTIFIER "${file}" file_id)
+    list(APPEND report_files "${file}")
+    list(APPEND ${kind}_${file_id} "${location}")
+  endforeach()
+endforeach()
+
+set(report "")
+if(report_files)
+  list(REMOVE_DUPLICATES report_files)
+  list(SORT report_files)
+endif()
+foreach(file ${report_files})
+  string(MAKE_C_IDENTIFIER "${file}" file_id)
+  if(vectorised_${file_id})
+    list(REMOVE_DUPLICATES vectorised_${file_id})
+    # A loop can be missed with a vector size, then vectorised with another one
+    list(REMOVE_ITEM missed_${file_id} ${vectorised_${file_id}})
+  endif()
+  if(missed_${file_id})
+    list(REMOVE_DUPLICATES missed_${file_id})
+  endif()
+  list(LENGTH vectorised_${file_id} vectorised_count)
+  list(LENGTH missed_${file_id} missed_count)
+  set(current_vectorised_count_${file_id} ${vectorised_count})
+
+  string(APPEND report "${file}: ${vectorised_count} vectorised, ${missed_count} missed\n")
+  foreach(location ${vectorised_${file_id}})
+    string(APPEND report "  vectorised: ${location}\n")
+  endforeach()
+  foreach(location ${missed_${file_id}})
+    string(APPEND report "  missed: ${location}\n")
+  endforeach()
+endforeach()
+
+file(WRITE "${report_file}" "${report}")
+message(STATUS "Vectorisation report written to ${report_file}")
+
+if(NOT baseline_file)
+  return()
+endif()
+
+if(NOT EXISTS "${baseline_file}")
+  message(FATAL_ERROR "The vectorisation report baseline ${baseline_file} doesn't exist. "
+    "Copy ${report_file} to create it."
+  )
+endif()
+
+unset(regressions)
+file(STRINGS "${baseline_file}" baseline_summaries REGEX ": [0-9]+ vectorised, ")
+foreach(summary ${baseline_summaries})
+  if(NOT summary MATCHES "^(.+): ([0-9]+) vectorised, [0-9]+ missed$")
+    continue()
+  endif()
+  set(file "${CMAKE_MATCH_1}")
+  set(baseline_vectorised_count "${CMAKE_MATCH_2}")
+  string(MAKE_C_IDENTIFIER "${file}" file_id)
+  set(vectorised_count 0)
+  if(DEFINED current_vectorised_count_${file_id})
+    set(vectorised_count ${current_vectorised_count_${file_id}})
+  endif()
+  if(vectorised_count LESS baseline_vectorised_count)
+    string(APPEND regressions "\n  ${file}: ${vectorised_count} vectorised loops "
+      "instead of ${baseline_vectorised_count}"
+    )
+  endif()
+endforeach()
+
+if(regressions)
+  message(FATAL_ERROR "Fewer loops are vectorised than in ${baseline_file}:${regressions}"
+    "\nSee ${report_file} for details, and copy it over the baseline if this is expected."
+  )
+endif()
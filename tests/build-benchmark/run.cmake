@@ -0,0 +1,429 @@
+# Copyright (c) 2018 Alain Martin
+#
+# This file is part of FRUT.
+#
+# FRUT is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# FRUT is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+# Measures how long it takes to build the projects of generated/JUCE-<version> with
+# Reprojucer.cmake. Run it from a build directory:
+#
+#   cmake -DJUCE_VERSION=<version> [-DJUCE_ROOT=<dir>] [-DPROJECTS=<name>...]
+#     [-DGENERATOR=<generator>] [-DCONFIGURATION=<config>] [-DPARALLEL_LEVEL=<n>]
+#     [-DCONFIGURE_ARGS=<arg>...] [-DBASELINE_DIR=<dir>]
+#     -P <FRUT>/tests/build-benchmark/run.cmake
+#
+# JUCE_ROOT defaults to ci/tmp/JUCE-<version>, where the CI clones JUCE. PROJECTS selects
+# the projects by the name of their .jucer file (e.g. HelloWorld), all the projects
+# supported on this platform are built by default.
+#
+# Each project is configured in a new build directory, then it is built:
+#
+#   - clean_build: from scratch,
+#   - null_build: again, without any changes,
+#   - touch_resource: after touching its first binary resource,
+#   - touch_source: after touching its first compiled .cpp file,
+#   - toggle_config_flag: after toggling JUCE_LOG_ASSERTIONS in jucer_project_module(),
+#     which regenerates AppConfig.h, so it also measures re-running CMake.
+#
+# The wall time, CPU time (user + system) and peak resident set size of each step are
+# written to build-benchmark/<project>.csv and build-benchmark/summary.csv. The CPU time
+# and peak RSS are measured with GNU or BSD time when it is available. When BASELINE_DIR
+# is given (i.e. the build-benchmark directory of a previous run), the wall times are
+# compared to the ones of this baseline.
+
+cmake_minimum_required(VERSION 3.23)
+
+
+if(NOT DEFINED JUCE_VERSION)
+  message(FATAL_ERROR "JUCE_VERSION must be defined")
+endif()
+
+get_filename_component(FRUT_ROOT "${CMAKE_CURRENT_LIST_DIR}/../.." ABSOLUTE)
+
+if(NOT DEFINED JUCE_ROOT)
+  set(JUCE_ROOT "${FRUT_ROOT}/ci/tmp/JUCE-${JUCE_VERSION}")
+endif()
+get_filename_component(JUCE_ROOT "${JUCE_ROOT}" ABSOLUTE)
+if(NOT IS_DIRECTORY "${JUCE_ROOT}")
+  message(FATAL_ERROR "No such directory: ${JUCE_ROOT}")
+endif()
+
+set(generated_JUCE_ROOT "${FRUT_ROOT}/generated/JUCE-${JUCE_VERSION}")
+if(NOT EXISTS "${generated_JUCE_ROOT}/CMakeLists.txt")
+  message(FATAL_ERROR "No such file: ${generated_JUCE_ROOT}/CMakeLists.txt")
+endif()
+
+if(NOT DEFINED PARALLEL_LEVEL)
+  cmake_host_system_information(RESULT PARALLEL_LEVEL QUERY NUMBER_OF_LOGICAL_CORES)
+endif()
+
+set(work_dir "${CMAKE_CURRENT_BINARY_DIR}/build-benchmark-projects")
+set(report_dir "${CMAKE_CURRENT_BINARY_DIR}/build-benchmark")
+set(steps configure clean_build null_build touch_resource touch_source toggle_config_flag)
+
+
+# GNU time writes its measures to a file, BSD time (e.g. on macOS) prints them to stderr
+find_program(TIME_EXE time)
+set(time_flavour "none")
+if(TIME_EXE)
+  execute_process(
+    COMMAND "${TIME_EXE}" -f "%M" -o "${CMAKE_CURRENT_BINARY_DIR}/time-check.txt" true
+    RESULT_VARIABLE time_check_result
+    OUTPUT_QUIET ERROR_QUIET
+  )
+  if(time_check_result EQUAL 0)
+    set(time_flavour "GNU")
+  else()
+    execute_process(
+      COMMAND "${TIME_EXE}" -l true
+      RESULT_VARIABLE time_check_result
+      OUTPUT_QUIET ERROR_QUIET
+    )
+    if(time_check_result EQUAL 0)
+      set(time_flavour "BSD")
+    endif()
+  endif()
+  file(REMOVE "${CMAKE_CURRENT_BINARY_DIR}/time-check.txt")
+endif()
+if(time_flavour STREQUAL "none")
+  message(WARNING "Neither GNU time nor BSD time was found, so only the wall time is "
+    "measured"
+  )
+endif()
+
+
+function(format_microseconds microseconds out_seconds)
+
+  math(EXPR seconds "${microseconds} / 1000000")
+  math(EXPR fraction "${microseconds} % 1000000 / 1000 + 1000")
+  string(SUBSTRING "${fraction}" 1 3 fraction)
+  set(${out_seconds} "${seconds}.${fraction}" PARENT_SCOPE)
+
+endfunction()
+
+
+# Converts a number of seconds printed by time (e.g. "12.3" or "12.34") to hundredths
+function(parse_hundredths seconds out_hundredths)
+
+  if(NOT seconds MATCHES "^([0-9]+)(\\.([0-9]*))?$")
+    message(FATAL_ERROR "Unexpected number of seconds: ${seconds}")
+  endif()
+  set(integer "${CMAKE_MATCH_1}")
+  string(SUBSTRING "${CMAKE_MATCH_3}00" 0 2 fraction)
+  math(EXPR hundredths "${integer} * 100 + 1${fraction} - 100")
+  set(${out_hundredths} ${hundredths} PARENT_SCOPE)
+
+endfunction()
+
+
+# Runs the command given after the log file, and returns the wall time in seconds, the
+# CPU time in seconds and the peak resident set size in KiB, or "-" when they are not
+# measured. Returns "failed" as wall time when the command fails.
+function(measure_command log_file out_wall out_cpu out_peak_rss)
+
+  set(time_file "${work_dir}/time.txt")
+  if(time_flavour STREQUAL "GNU")
+    set(time_command "${TIME_EXE}" -f "%U %S %M" -o "${time_file}")
+  elseif(time_flavour STREQUAL "BSD")
+    set(time_command "${TIME_EXE}" -l)
+  else()
+    set(time_command)
+  endif()
+
+  string(TIMESTAMP begin_time "%s%f")
+  execute_process(
+    COMMAND ${time_command} ${ARGN}
+    OUTPUT_VARIABLE command_output
+    ERROR_VARIABLE command_error
+    RESULT_VARIABLE command_result
+  )
+  string(TIMESTAMP end_time "%s%f")
+  file(APPEND "${log_file}" "${command_output}${command_error}")
+
+  set(${out_cpu} "-" PARENT_SCOPE)
+  set(${out_peak_rss} "-" PARENT_SCOPE)
+  if(NOT command_result EQUAL 0)
+    set(${out_wall} "failed" PARENT_SCOPE)
+    return()
+  endif()
+
+  math(EXPR wall "${end_time} - ${begin_time}")
+  format_microseconds(${wall} wall)
+  set(${out_wall} ${wall} PARENT_SCOPE)
+
+  if(time_flavour STREQUAL "GNU")
+    file(STRINGS "${time_file}" time_lines REGEX "^[0-9.]+ [0-9.]+ [0-9]+$")
+    list(GET time_lines -1 time_line)
+    string(REPLACE " " ";" time_measures "${time_line}")
+    list(GET time_measures 0 user)
+    list(GET time_measures 1 system)
+    list(GET time_measures 2 peak_rss)
+  elseif(time_flavour STREQUAL "BSD")
+    if(NOT command_error MATCHES
+        "([0-9.]+) real +([0-9.]+) user +([0-9.]+) sys\n *([0-9]+) +maximum resident")
+      message(FATAL_ERROR "Could not find the output of ${TIME_EXE} in:\n"
+        "${command_error}"
+      )
+    endif()
+    set(user "${CMAKE_MATCH_2}")
+    set(system "${CMAKE_MATCH_3}")
+    # BSD time reports the maximum resident set size in bytes
+    math(EXPR peak_rss "${CMAKE_MATCH_4} / 1024")
+  else()
+    return()
+  endif()
+
+  parse_hundredths("${user}" user)
+  parse_hundredths("${system}" system)
+  math(EXPR cpu "${user} + ${system}")
+  math(EXPR cpu_integer "${cpu} / 100")
+  math(EXPR cpu_fraction "${cpu} % 100 + 100")
+  string(SUBSTRING "${cpu_fraction}" 1 2 cpu_fraction)
+  set(${out_cpu} "${cpu_integer}.${cpu_fraction}" PARENT_SCOPE)
+  set(${out_peak_rss} ${peak_rss} PARENT_SCOPE)
+
+endfunction()
+
+
+# Lists the projects added by generated/JUCE-<version>/CMakeLists.txt, with the .jucer
+# file and the condition under which each project is added
+set(all_projects)
+set(condition "TRUE")
+unset(project_name)
+file(STRINGS "${generated_JUCE_ROOT}/CMakeLists.txt" lines)
+foreach(line ${lines})
+  if(line MATCHES "^if\\((.*)\\)$")
+    set(condition "${CMAKE_MATCH_1}")
+  elseif(line MATCHES "^endif\\(\\)$")
+    set(condition "TRUE")
+  elseif(line MATCHES "^ *set\\(([A-Za-z0-9_]+)_jucer_FILE")
+    set(project_name "${CMAKE_MATCH_1}")
+  endif()
+  if(DEFINED project_name AND line MATCHES "\"\\\${JUCE_ROOT}/([^\"]+)\"")
+    set(${project_name}_jucer_file "${JUCE_ROOT}/${CMAKE_MATCH_1}")
+  endif()
+  if(DEFINED project_name AND line MATCHES "^ *add_subdirectory\\(\"([^\"]+)\"\\)$")
+    list(APPEND all_projects ${project_name})
+    set(${project_name}_dir "${generated_JUCE_ROOT}/${CMAKE_MATCH_1}")
+    set(${project_name}_condition "${condition}")
+    unset(project_name)
+  endif()
+endforeach()
+
+if(NOT DEFINED PROJECTS)
+  set(PROJECTS ${all_projects})
+endif()
+foreach(project_name ${PROJECTS})
+  if(NOT project_name IN_LIST all_projects)
+    message(FATAL_ERROR "Unknown project: ${project_name}\n"
+      "Known projects: ${all_projects}"
+    )
+  endif()
+endforeach()
+
+
+set(configure_args)
+if(DEFINED GENERATOR)
+  list(APPEND configure_args -G "${GENERATOR}")
+endif()
+set(build_args --parallel ${PARALLEL_LEVEL})
+if(DEFINED CONFIGURATION)
+  list(APPEND configure_args "-DCMAKE_BUILD_TYPE=${CONFIGURATION}")
+  list(APPEND build_args --config "${CONFIGURATION}")
+endif()
+list(APPEND configure_args ${CONFIGURE_ARGS})
+
+execute_process(
+  COMMAND git rev-parse HEAD
+  WORKING_DIRECTORY "${FRUT_ROOT}"
+  OUTPUT_VARIABLE FRUT_commit
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+  ERROR_QUIET
+)
+
+file(REMOVE_RECURSE "${report_dir}")
+file(MAKE_DIRECTORY "${report_dir}")
+file(WRITE "${report_dir}/environment.txt"
+  "FRUT commit: ${FRUT_commit}\n"
+  "JUCE version: ${JUCE_VERSION}\n"
+  "CMake version: ${CMAKE_VERSION}\n"
+  "Generator: ${GENERATOR}\n"
+  "Configuration: ${CONFIGURATION}\n"
+  "Parallel level: ${PARALLEL_LEVEL}\n"
+  "Configure arguments: ${CONFIGURE_ARGS}\n"
+  "Time: ${time_flavour}\n"
+)
+set(csv_header "step,wall_s,cpu_s,peak_rss_kib")
+set(summary "project,${csv_header}\n")
+
+unset(failed_projects)
+foreach(project_name ${PROJECTS})
+  message(STATUS "${project_name}")
+
+  # The CMakeLists.txt of the project is copied, so that the config flag can be toggled
+  # without touching the generated one. The copy also skips the projects that are not
+  # added by generated/JUCE-<version>/CMakeLists.txt on this platform.
+  set(project_dir "${work_dir}/${project_name}")
+  set(build_dir "${project_dir}/build")
+  set(log_file "${project_dir}/build.log")
+  file(REMOVE_RECURSE "${project_dir}")
+  file(READ "${${project_name}_dir}/CMakeLists.txt" project_content)
+  string(REPLACE "\${CMAKE_CURRENT_LIST_DIR}" "${${project_name}_dir}"
+    project_content "${project_content}"
+  )
+  string(REGEX REPLACE "(\nproject\\([^\n]*\\)\n)" "\\1
+if(NOT (${${project_name}_condition}))
+  file(WRITE \"\${CMAKE_BINARY_DIR}/unsupported\" \"\")
+  return()
+endif()
+" project_content "${project_content}")
+  file(WRITE "${project_dir}/CMakeLists.txt" "${project_content}")
+
+  unset(resource_file)
+  unset(source_file)
+  get_filename_component(jucer_dir "${${project_name}_jucer_file}" DIRECTORY)
+  if(project_content MATCHES "\n  [x.] +[x.] +x +\"([^\"]+)\"\n")
+    get_filename_component(resource_file "${CMAKE_MATCH_1}" ABSOLUTE
+      BASE_DIR "${jucer_dir}"
+    )
+  endif()
+  if(project_content MATCHES "\n  x +[x.] +[x.] +\"([^\"]+\\.cpp)\"\n")
+    get_filename_component(source_file "${CMAKE_MATCH_1}" ABSOLUTE
+      BASE_DIR "${jucer_dir}"
+    )
+  endif()
+
+  set(csv "${csv_header}\n")
+  set(failed FALSE)
+  foreach(step ${steps})
+    set(command "${CMAKE_COMMAND}" --build "${build_dir}" ${build_args})
+    if(step STREQUAL "configure")
+      set(command "${CMAKE_COMMAND}" -S "${project_dir}" -B "${build_dir}"
+        ${configure_args}
+        "-D${project_name}_jucer_FILE=${${project_name}_jucer_file}"
+      )
+    elseif(step STREQUAL "touch_resource")
+      if(NOT DEFINED resource_file)
+        string(APPEND csv "${step},-,-,-\n")
+        continue()
+      endif()
+      file(TOUCH_NOCREATE "${resource_file}")
+    elseif(step STREQUAL "touch_source")
+      if(NOT DEFINED source_file)
+        string(APPEND csv "${step},-,-,-\n")
+        continue()
+      endif()
+      file(TOUCH_NOCREATE "${source_file}")
+    elseif(step STREQUAL "toggle_config_flag")
+      set(flag_content "${project_content}")
+      if(flag_content MATCHES "\n  # JUCE_LOG_ASSERTIONS\n")
+        string(REPLACE "\n  # JUCE_LOG_ASSERTIONS\n" "\n  JUCE_LOG_ASSERTIONS ON\n"
+          flag_content "${flag_content}"
+        )
+      elseif(flag_content MATCHES "\n  JUCE_LOG_ASSERTIONS ON\n")
+        string(REPLACE "\n  JUCE_LOG_ASSERTIONS ON\n" "\n  JUCE_LOG_ASSERTIONS OFF\n"
+          flag_content "${flag_content}"
+        )
+      elseif(flag_content MATCHES "\n  JUCE_LOG_ASSERTIONS OFF\n")
+        string(REPLACE "\n  JUCE_LOG_ASSERTIONS OFF\n" "\n  JUCE_LOG_ASSERTIONS ON\n"
+          flag_content "${flag_content}"
+        )
+      else()
+        string(APPEND csv "${step},-,-,-\n")
+        continue()
+      endif()
+      file(WRITE "${project_dir}/CMakeLists.txt" "${flag_content}")
+    endif()
+
+    file(APPEND "${log_file}" "\n-- ${step}\n")
+    measure_command("${log_file}" wall cpu peak_rss ${command})
+    string(APPEND csv "${step},${wall},${cpu},${peak_rss}\n")
+    if(wall STREQUAL "failed")
+      message(STATUS "  ${step} failed, see ${log_file}")
+      set(failed TRUE)
+      break()
+    endif()
+    if(cpu STREQUAL "-")
+      message(STATUS "  ${step}: ${wall} s wall")
+    else()
+      message(STATUS "  ${step}: ${wall} s wall, ${cpu} s CPU, ${peak_rss} KiB peak RSS")
+    endif()
+
+    if(step STREQUAL "configure" AND EXISTS "${build_dir}/unsupported")
+      message(STATUS "  Not supported on this platform")
+      set(csv "${csv_header}\n")
+      break()
+    endif()
+  endforeach()
+
+  if(failed)
+    list(APPEND failed_projects ${project_name})
+  endif()
+  file(WRITE "${report_dir}/${project_name}.csv" "${csv}")
+  string(REGEX REPLACE "\n([^\n])" "\n${project_name},\\1" csv "\n${csv}")
+  string(REGEX REPLACE "^\n[^\n]*\n" "" csv "${csv}")
+  string(APPEND summary "${csv}")
+endforeach()
+
+file(WRITE "${report_dir}/summary.csv" "${summary}")
+message(STATUS "Results written to ${report_dir}")
+
+
+if(DEFINED BASELINE_DIR)
+  if(NOT EXISTS "${BASELINE_DIR}/summary.csv")
+    message(FATAL_ERROR "No such file: ${BASELINE_DIR}/summary.csv")
+  endif()
+
+  file(STRINGS "${BASELINE_DIR}/summary.csv" baseline_lines)
+  foreach(line ${baseline_lines})
+    if(line MATCHES "^([^,]+),([^,]+),([0-9]+)\\.([0-9]+),")
+      math(EXPR baseline_${CMAKE_MATCH_1}_${CMAKE_MATCH_2}
+        "${CMAKE_MATCH_3} * 1000 + ${CMAKE_MATCH_4}"
+      )
+    endif()
+  endforeach()
+
+  message(STATUS "Wall times compared to ${BASELINE_DIR}:")
+  file(STRINGS "${report_dir}/summary.csv" lines)
+  foreach(line ${lines})
+    if(NOT line MATCHES "^([^,]+),([^,]+),([0-9]+)\\.([0-9]+),")
+      continue()
+    endif()
+    set(project_name "${CMAKE_MATCH_1}")
+    set(step "${CMAKE_MATCH_2}")
+    if(NOT DEFINED baseline_${project_name}_${step})
+      continue()
+    endif()
+    math(EXPR wall "${CMAKE_MATCH_3} * 1000 + ${CMAKE_MATCH_4}")
+    set(baseline_wall ${baseline_${project_name}_${step}})
+    format_microseconds("${baseline_wall}000" baseline_seconds)
+    format_microseconds("${wall}000" seconds)
+    if(baseline_wall EQUAL 0)
+      set(change "")
+    else()
+      math(EXPR change "(${wall} - ${baseline_wall}) * 100 / ${baseline_wall}")
+      if(NOT change LESS 0)
+        set(change "+${change}")
+      endif()
+      set(change " (${change}%)")
+    endif()
+    message(STATUS "  ${project_name} ${step}: "
+      "${baseline_seconds} s -> ${seconds} s${change}"
+    )
+  endforeach()
+endif()
+
+if(failed_projects)
+  message(FATAL_ERROR "Failed to build: ${failed_projects}")
+endif()
@@ -0,0 +1,189 @@
+# Copyright (c) 2018 Alain Martin
+#
+# This file is part of FRUT.
+#
+# FRUT is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# FRUT is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+# Writes a synthetic Reprojucer project to OUTPUT_DIR, in the same form as the projects
+# written by Jucer2Reprojucer:
+#
+#   cmake -DOUTPUT_DIR=<dir>
+#     -DFILE_COUNT=<n> -DGROUP_COUNT=<n> -DMODULE_COUNT=<n> -DRESOURCE_COUNT=<n>
+#     -DCONFIGURATION_COUNT=<n> [-DJUCE_MODULES_DIR=<dir>]
+#     -P generate-project.cmake
+#
+# Half of the files are compiled, the other half are headers. Binary resources need
+# frut-tools, which is built from the JUCE modules in JUCE_MODULES_DIR.
+
+cmake_minimum_required(VERSION 3.4)
+
+
+foreach(variable OUTPUT_DIR FILE_COUNT GROUP_COUNT MODULE_COUNT RESOURCE_COUNT
+    CONFIGURATION_COUNT)
+  if(NOT DEFINED ${variable})
+    message(FATAL_ERROR "${variable} must be defined")
+  endif()
+endforeach()
+if(RESOURCE_COUNT GREATER 0 AND NOT DEFINED JUCE_MODULES_DIR)
+  message(FATAL_ERROR "JUCE_MODULES_DIR must be defined when RESOURCE_COUNT is not 0")
+endif()
+if(GROUP_COUNT LESS 1 OR CONFIGURATION_COUNT LESS 1)
+  message(FATAL_ERROR "GROUP_COUNT and CONFIGURATION_COUNT must be at least 1")
+endif()
+
+get_filename_component(FRUT_cmake_DIR "${CMAKE_CURRENT_LIST_DIR}/../../cmake" ABSOLUTE)
+
+
+function(write_file_if_missing path content)
+
+  if(NOT EXISTS "${path}")
+    file(WRITE "${path}" "${content}")
+  endif()
+
+endfunction()
+
+
+set(project "cmake_minimum_required(VERSION 3.4)
+
+project(\"synthetic\")
+
+
+list(APPEND CMAKE_MODULE_PATH \"${FRUT_cmake_DIR}\")
+include(Reprojucer)
+
+
+jucer_project_begin(
+  PROJECT_FILE \"\${CMAKE_CURRENT_LIST_DIR}/synthetic.jucer\"
+)
+
+jucer_project_settings(
+  PROJECT_NAME \"synthetic\"
+  PROJECT_VERSION \"1.0.0\"
+  PROJECT_TYPE \"Console Application\"
+)
+
+jucer_project_files(\"synthetic/Source\"
+  x         .         .         \"Source/Main.cpp\"
+)
+
+")
+write_file_if_missing("${OUTPUT_DIR}/synthetic.jucer" "")
+write_file_if_missing("${OUTPUT_DIR}/Source/Main.cpp" "int main() { return 0; }\n")
+
+set(file_index 0)
+math(EXPR last_group "${GROUP_COUNT} - 1")
+foreach(group RANGE ${last_group})
+  # Spreads the files evenly over the groups
+  math(EXPR group_end "(${group} + 1) * ${FILE_COUNT} / ${GROUP_COUNT}")
+  string(APPEND project "jucer_project_files(\"synthetic/Source/Group${group}\"\n")
+  while(file_index LESS group_end)
+    math(EXPR is_header "${file_index} % 2")
+    if(is_header)
+      set(path "Source/Group${group}/File${file_index}.h")
+      string(APPEND project "  .         .         .         \"${path}\"\n")
+      write_file_if_missing("${OUTPUT_DIR}/${path}" "#pragma once\n")
+    else()
+      set(path "Source/Group${group}/File${file_index}.cpp")
+      string(APPEND project "  x         .         .         \"${path}\"\n")
+      write_file_if_missing("${OUTPUT_DIR}/${path}" "")
+    endif()
+    math(EXPR file_index "${file_index} + 1")
+  endwhile()
+  string(APPEND project ")\n\n")
+endforeach()
+
+if(RESOURCE_COUNT GREATER 0)
+  string(APPEND project "jucer_project_files(\"synthetic/Resources\"\n")
+  math(EXPR last_resource "${RESOURCE_COUNT} - 1")
+  foreach(resource RANGE ${last_resource})
+    set(path "Resources/Resource${resource}.bin")
+    string(APPEND project "  .         .         x         \"${path}\"\n")
+    write_file_if_missing("${OUTPUT_DIR}/${path}" "Resource${resource}\n")
+  endforeach()
+  string(APPEND project ")\n\n")
+
+  # frut-tools is looked for in the folders of the modules of the project
+  string(APPEND project "jucer_project_module(\n  juce_core\n"
+    "  PATH \"${JUCE_MODULES_DIR}\"\n)\n\n"
+  )
+endif()
+
+if(MODULE_COUNT GREATER 0)
+  math(EXPR last_module "${MODULE_COUNT} - 1")
+  foreach(module RANGE ${last_module})
+    set(module_name "synthetic_module_${module}")
+    string(TOUPPER "${module_name}" upper_module_name)
+    set(module_dir "${OUTPUT_DIR}/modules/${module_name}")
+    write_file_if_missing("${module_dir}/${module_name}.h" "/*
+ BEGIN_JUCE_MODULE_DECLARATION
+
+  ID:               ${module_name}
+  vendor:           synthetic
+  version:          1.0.0
+  name:             Synthetic module ${module}
+  dependencies:
+  linuxLibs:        pthread
+
+ END_JUCE_MODULE_DECLARATION
+*/
+
+#pragma once
+
+/** Config: ${upper_module_name}_FIRST_FLAG
+*/
+
+/** Config: ${upper_module_name}_SECOND_FLAG
+*/
+")
+    write_file_if_missing("${module_dir}/${module_name}.cpp"
+      "#include \"${module_name}.h\"\n"
+    )
+    # Like the JUCE modules, most of the files are in sub-folders
+    foreach(sub_folder_index RANGE 4)
+      foreach(sub_file_index RANGE 9)
+        write_file_if_missing(
+          "${module_dir}/folder${sub_folder_index}/file${sub_file_index}.cpp" ""
+        )
+      endforeach()
+    endforeach()
+
+    string(APPEND project "jucer_project_module(\n  ${module_name}\n"
+      "  PATH \"\${CMAKE_CURRENT_LIST_DIR}/modules\"\n"
+      "  ${upper_module_name}_FIRST_FLAG ON\n)\n\n"
+    )
+  endforeach()
+endif()
+
+foreach(exporter "Xcode (MacOSX)" "Visual Studio 2017" "Linux Makefile")
+  string(APPEND project "jucer_export_target(\n  \"${exporter}\"\n)\n\n")
+
+  math(EXPR last_configuration "${CONFIGURATION_COUNT} - 1")
+  foreach(configuration RANGE ${last_configuration})
+    math(EXPR is_release "${configuration} % 2")
+    if(is_release)
+      set(debug_mode "OFF")
+    else()
+      set(debug_mode "ON")
+    endif()
+    string(APPEND project "jucer_export_target_configuration(\n"
+      "  \"${exporter}\"\n"
+      "  NAME \"Configuration${configuration}\"\n"
+      "  DEBUG_MODE ${debug_mode}\n)\n\n"
+    )
+  endforeach()
+endforeach()
+
+string(APPEND project "jucer_project_end()\n")
+
+file(WRITE "${OUTPUT_DIR}/CMakeLists.txt" "${project}")
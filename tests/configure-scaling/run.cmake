@@ -0,0 +1,252 @@
+# Copyright (c) 2018 Alain Martin
+#
+# This file is part of FRUT.
+#
+# FRUT is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# FRUT is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+# Measures how the time spent configuring and generating a Reprojucer project grows with
+# the number of files, groups, modules, resources and configurations. Run it from a build
+# directory:
+#
+#   cmake [-DJUCE_MODULES_DIR=<dir>] [-DDIMENSIONS=<dimension>...] [-DREPETITIONS=<n>]
+#     -P <FRUT>/tests/configure-scaling/run.cmake
+#
+# Each dimension is increased while the other ones keep their base value. Each point is
+# configured REPETITIONS times (2 by default), and the fastest time is written to
+# configure-scaling.csv. The resources are only measured when
+# JUCE_MODULES_DIR is given, since frut-tools is needed to generate BinaryData.
+#
+# The script fails when multiplying a dimension by N makes configuring and generating, or
+# the jucer_* functions alone, take more than MAX_SLOWDOWN_PERCENT percent of N times
+# longer (150 by default). Linear growth stays below 100 percent, while quadratic growth
+# quickly goes above.
+
+cmake_minimum_required(VERSION 3.23)
+
+
+set(base_FILE_COUNT 2000)
+set(base_GROUP_COUNT 20)
+set(base_MODULE_COUNT 4)
+set(base_RESOURCE_COUNT 0)
+set(base_CONFIGURATION_COUNT 2)
+
+set(points_FILE_COUNT 2000 4000 8000)
+set(points_GROUP_COUNT 20 80 320)
+set(points_MODULE_COUNT 4 8 16)
+set(points_RESOURCE_COUNT 20 40 80)
+set(points_CONFIGURATION_COUNT 2 4 8)
+
+set(all_dimensions FILE_COUNT GROUP_COUNT MODULE_COUNT RESOURCE_COUNT CONFIGURATION_COUNT)
+if(NOT DEFINED DIMENSIONS)
+  set(DIMENSIONS ${all_dimensions})
+  if(NOT DEFINED JUCE_MODULES_DIR)
+    list(REMOVE_ITEM DIMENSIONS RESOURCE_COUNT)
+  endif()
+endif()
+if(NOT DEFINED REPETITIONS)
+  set(REPETITIONS 2)
+endif()
+if(NOT DEFINED MAX_SLOWDOWN_PERCENT)
+  set(MAX_SLOWDOWN_PERCENT 150)
+endif()
+
+set(work_dir "${CMAKE_CURRENT_BINARY_DIR}/configure-scaling")
+set(csv_file "${CMAKE_CURRENT_BINARY_DIR}/configure-scaling.csv")
+set(measured_functions jucer_project_files jucer_project_module jucer_project_end)
+
+
+function(format_microseconds microseconds out_milliseconds)
+
+  math(EXPR milliseconds "${microseconds} / 1000")
+  math(EXPR fraction "${microseconds} % 1000 + 1000")
+  string(SUBSTRING "${fraction}" 1 3 fraction)
+  set(${out_milliseconds} "${milliseconds}.${fraction}" PARENT_SCOPE)
+
+endfunction()
+
+
+function(format_hundredths hundredths out_value)
+
+  math(EXPR integer "${hundredths} / 100")
+  math(EXPR fraction "${hundredths} % 100 + 100")
+  string(SUBSTRING "${fraction}" 1 2 fraction)
+  set(${out_value} "${integer}.${fraction}" PARENT_SCOPE)
+
+endfunction()
+
+
+# Configures and generates the project in project_dir REPETITIONS times, and returns the
+# fastest total time, and the time spent in all the jucer_* functions and in each
+# measured function during that run, in microseconds
+function(configure_project project_dir build_dir out_total out_jucer out_functions)
+
+  unset(best_total)
+  foreach(repetition RANGE 1 ${REPETITIONS})
+    configure_project_once("${project_dir}" "${build_dir}" total jucer functions)
+    if(NOT DEFINED best_total OR total LESS best_total)
+      set(best_total ${total})
+      set(${out_total} ${total} PARENT_SCOPE)
+      set(${out_jucer} ${jucer} PARENT_SCOPE)
+      set(${out_functions} ${functions} PARENT_SCOPE)
+    endif()
+  endforeach()
+
+endfunction()
+
+
+function(configure_project_once project_dir build_dir out_total out_jucer out_functions)
+
+  string(TIMESTAMP begin_time "%s%f")
+  execute_process(
+    COMMAND "${CMAKE_COMMAND}"
+    -S "${project_dir}" -B "${build_dir}"
+    "-DFRUT_PROFILE_CONFIGURE=ON"
+    OUTPUT_VARIABLE configure_output
+    ERROR_VARIABLE configure_output
+    RESULT_VARIABLE configure_result
+  )
+  string(TIMESTAMP end_time "%s%f")
+  if(NOT configure_result EQUAL 0)
+    message("${configure_output}")
+    message(FATAL_ERROR "Failed to configure ${project_dir}")
+  endif()
+  math(EXPR total "${end_time} - ${begin_time}")
+
+  set(jucer_total 0)
+  unset(functions)
+  file(STRINGS "${build_dir}/FRUT-configure-summary.txt" summary_lines)
+  foreach(function_name ${measured_functions})
+    set(function_total_${function_name} 0)
+  endforeach()
+  foreach(line ${summary_lines})
+    if(line MATCHES "^ *([0-9]+)\\.([0-9]+) .* (jucer_[a-z_]+)$")
+      math(EXPR function_total "${CMAKE_MATCH_1} * 1000 + ${CMAKE_MATCH_2}")
+      math(EXPR jucer_total "${jucer_total} + ${function_total}")
+      set(function_total_${CMAKE_MATCH_3} ${function_total})
+    endif()
+  endforeach()
+  foreach(function_name ${measured_functions})
+    list(APPEND functions ${function_total_${function_name}})
+  endforeach()
+
+  set(${out_total} ${total} PARENT_SCOPE)
+  set(${out_jucer} ${jucer_total} PARENT_SCOPE)
+  set(${out_functions} ${functions} PARENT_SCOPE)
+
+endfunction()
+
+
+set(csv "dimension")
+foreach(dimension ${all_dimensions})
+  string(TOLOWER "${dimension}" column)
+  string(APPEND csv ",${column}")
+endforeach()
+string(APPEND csv ",configure_generate_ms,jucer_functions_ms")
+foreach(function_name ${measured_functions})
+  string(APPEND csv ",${function_name}_ms")
+endforeach()
+string(APPEND csv "\n")
+
+unset(failures)
+foreach(dimension ${DIMENSIONS})
+  if(NOT DEFINED points_${dimension})
+    message(FATAL_ERROR "Unknown dimension: ${dimension}\n"
+      "Known dimensions: ${all_dimensions}"
+    )
+  endif()
+
+  # The project is generated again in the same directory for each point, so that the
+  # build directory can be reused, without detecting the compiler again
+  set(project_dir "${work_dir}/${dimension}")
+  set(build_dir "${work_dir}/${dimension}/build")
+  set(first_point TRUE)
+  foreach(point ${points_${dimension}})
+    set(generate_args)
+    foreach(parameter ${all_dimensions})
+      if(parameter STREQUAL dimension)
+        list(APPEND generate_args "-D${parameter}=${point}")
+      else()
+        list(APPEND generate_args "-D${parameter}=${base_${parameter}}")
+      endif()
+    endforeach()
+    if(DEFINED JUCE_MODULES_DIR)
+      list(APPEND generate_args "-DJUCE_MODULES_DIR=${JUCE_MODULES_DIR}")
+    endif()
+    execute_process(
+      COMMAND "${CMAKE_COMMAND}" "-DOUTPUT_DIR=${project_dir}" ${generate_args}
+      -P "${CMAKE_CURRENT_LIST_DIR}/generate-project.cmake"
+      RESULT_VARIABLE generate_result
+    )
+    if(NOT generate_result EQUAL 0)
+      message(FATAL_ERROR "Failed to generate the project for ${dimension}=${point}")
+    endif()
+
+    if(first_point)
+      # Detects the compiler (and builds frut-tools if needed) before measuring
+      configure_project("${project_dir}" "${build_dir}" total jucer functions)
+    endif()
+    configure_project("${project_dir}" "${build_dir}" total jucer functions)
+
+    string(TOLOWER "${dimension}" dimension_name)
+    set(csv_line "${dimension_name}")
+    foreach(parameter ${all_dimensions})
+      if(parameter STREQUAL dimension)
+        string(APPEND csv_line ",${point}")
+      else()
+        string(APPEND csv_line ",${base_${parameter}}")
+      endif()
+    endforeach()
+    foreach(microseconds ${total} ${jucer} ${functions})
+      format_microseconds(${microseconds} milliseconds)
+      string(APPEND csv_line ",${milliseconds}")
+    endforeach()
+    string(APPEND csv "${csv_line}\n")
+    format_microseconds(${total} total_ms)
+    format_microseconds(${jucer} jucer_ms)
+    message(STATUS "${dimension}=${point}: ${total_ms} ms, ${jucer_ms} ms in jucer_*")
+
+    if(first_point)
+      set(first_value ${point})
+      set(first_total ${total})
+      set(first_jucer ${jucer})
+      set(first_point FALSE)
+    endif()
+    set(last_value ${point})
+  endforeach()
+
+  math(EXPR growth "${last_value} / ${first_value}")
+  math(EXPR max_time_ratio_x100 "${growth} * ${MAX_SLOWDOWN_PERCENT}")
+  foreach(measure total jucer)
+    math(EXPR time_ratio_x100 "${${measure}} * 100 / ${first_${measure}}")
+    if(time_ratio_x100 GREATER max_time_ratio_x100)
+      if(measure STREQUAL "total")
+        set(measure_name "configuring and generating")
+      else()
+        set(measure_name "the jucer_* functions")
+      endif()
+      format_hundredths(${time_ratio_x100} time_ratio)
+      format_hundredths(${max_time_ratio_x100} max_time_ratio)
+      string(APPEND failures "\n  ${dimension} x${growth}: ${measure_name} took "
+        "${time_ratio} times longer (the limit is ${max_time_ratio})"
+      )
+    endif()
+  endforeach()
+endforeach()
+
+file(WRITE "${csv_file}" "${csv}")
+message(STATUS "Results written to ${csv_file}")
+
+if(failures)
+  message(FATAL_ERROR "Configuring doesn't scale linearly:${failures}")
+endif()
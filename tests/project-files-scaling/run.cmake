@@ -0,0 +1,76 @@
+# Copyright (c) 2018 Alain Martin
+#
+# This file is part of FRUT.
+#
+# FRUT is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# FRUT is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+# Configures the project in this directory with a small and a large number of files, and
+# fails if the time spent in jucer_project_files() grows much faster than the number of
+# files. Run it from a build directory:
+#
+#   cmake -P <FRUT>/tests/project-files-scaling/run.cmake
+
+cmake_minimum_required(VERSION 3.23)
+
+
+set(small_file_count 2000)
+set(large_file_count 16000)
+# Linear growth gives a ratio of 8, quadratic growth a ratio of 64
+set(max_ratio 12)
+
+foreach(size small large)
+  set(build_dir "${CMAKE_CURRENT_BINARY_DIR}/project-files-scaling-${size}")
+  execute_process(
+    COMMAND "${CMAKE_COMMAND}"
+    -S "${CMAKE_CURRENT_LIST_DIR}" -B "${build_dir}"
+    "-DFILE_COUNT=${${size}_file_count}"
+    "-DFRUT_PROFILE_CONFIGURE=ON"
+    OUTPUT_VARIABLE configure_output
+    ERROR_VARIABLE configure_output
+    RESULT_VARIABLE configure_result
+  )
+  if(NOT configure_result EQUAL 0)
+    message("${configure_output}")
+    message(FATAL_ERROR "Failed to configure ${build_dir}")
+  endif()
+
+  file(STRINGS "${build_dir}/FRUT-configure-summary.txt" summary_line
+    REGEX " jucer_project_files$"
+  )
+  if(NOT summary_line MATCHES "^ *([0-9]+)\\.([0-9]+) ")
+    message(FATAL_ERROR
+      "No jucer_project_files in ${build_dir}/FRUT-configure-summary.txt"
+    )
+  endif()
+  set(${size}_ms "${CMAKE_MATCH_1}.${CMAKE_MATCH_2}")
+  math(EXPR ${size}_us "${CMAKE_MATCH_1} * 1000 + ${CMAKE_MATCH_2}")
+  message(STATUS
+    "jucer_project_files() with ${${size}_file_count} files: ${${size}_ms} ms"
+  )
+endforeach()
+
+math(EXPR ratio_x100 "${large_us} * 100 / ${small_us}")
+math(EXPR ratio_integer "${ratio_x100} / 100")
+math(EXPR ratio_fraction "${ratio_x100} % 100 + 100")
+string(SUBSTRING "${ratio_fraction}" 1 2 ratio_fraction)
+math(EXPR max_ratio_x100 "${max_ratio} * 100")
+math(EXPR file_count_ratio "${large_file_count} / ${small_file_count}")
+message(STATUS "${file_count_ratio} times more files took "
+  "${ratio_integer}.${ratio_fraction} times longer"
+)
+if(ratio_x100 GREATER max_ratio_x100)
+  message(FATAL_ERROR "jucer_project_files() doesn't scale linearly with the number of "
+    "files: ${file_count_ratio} times more files took more than ${max_ratio} times longer"
+  )
+endif()